@@ -124,9 +124,6 @@ static void hardware_init()
     // --- Audio (placeholder : moteur prêt mais pas de musique chargée) ---
     baba::audio_init();
 
-    // --- Sprites (atlas 16×16) ---
-    baba::sprites_init();
-
     // --- Logique de jeu ---
     baba::game_init();
 
@@ -13,8 +13,10 @@
 
   Notes :
     - La grille ne contient aucune logique de gameplay.
-    - Chaque cellule contient une pile d’objets (vector<Object>).
-    - Le moteur peut donc empiler plusieurs objets dans une même case.
+    - Chaque cellule contient une pile d’objets stockée dans l’arène plate
+      de la grille (inline, ou dans un bloc de débordement si elle grossit).
+    - Le moteur peut donc empiler plusieurs objets dans une même case,
+      sans aucune allocation dynamique pendant le jeu.
 
   Auteur : Jean-Charles LEBEAU
   Date   : Janvier 2026
@@ -22,9 +24,9 @@
 */
 
 #include "grid.h"
-#include "assets/gfx/atlas.h"
-#include "graphics_basic.h"
-#include "sprites.h"
+#include "undo.h"
+#include <cstdio>
+#include <cstring>
 
 namespace baba {
 
@@ -32,9 +34,37 @@ namespace baba {
 //  Constructeur : crée une grille w×h avec des cellules vides
 // -----------------------------------------------------------------------------
 Grid::Grid(int w, int h)
-    : width(w), height(h), cells(w * h)
 {
-    // Rien d’autre à faire : chaque Cell contient un vector<Object> vide.
+    reset(w, h);
+}
+
+// -----------------------------------------------------------------------------
+//  Vide la grille en place (aucune réallocation)
+// -----------------------------------------------------------------------------
+void Grid::reset(int w, int h)
+{
+    width  = w;
+    height = h;
+
+    for (auto& s : slots) {
+        s.count = 0;
+        s.spill = NO_SPILL;
+    }
+    spillUsed = 0;
+    hash      = 0;
+    overflowed = 0;
+    cellTypes.fill(0);
+    for (auto& set : typeCells) set.clear();
+    effects.clear();
+
+    playMinX = playMinY = 0;
+    playMaxX = playMaxY = 0;
+
+    // Nouveau contenu : l’historique d’annulation ne s’applique plus
+    if (journal) journal->clear();
+
+    // Le contenu a changé partout : toutes les phrases sont à réévaluer
+    mark_all_text_dirty();
 }
 
 // -----------------------------------------------------------------------------
@@ -47,29 +77,268 @@ bool Grid::in_bounds(int x, int y) const
 }
 
 // -----------------------------------------------------------------------------
-//  Accès en écriture à une cellule
+//  Empreinte de l’état (contenu tenu à jour + géométrie)
+// -----------------------------------------------------------------------------
+uint64_t Grid::state_hash() const
+{
+    // Géométrie : une clé de plus, marquée au-delà de la plage des objets
+    uint64_t geo = (uint64_t)(uint8_t)width          | (uint64_t)(uint8_t)height   << 8
+                 | (uint64_t)(uint8_t)playMinX << 16 | (uint64_t)(uint8_t)playMinY << 24
+                 | (uint64_t)(uint8_t)playMaxX << 32 | (uint64_t)(uint8_t)playMaxY << 40
+                 | 1ull << 63;
+    return hash + hash_mix(geo);
+}
+
+uint64_t Grid::compute_hash() const
+{
+    uint64_t h = 0;
+    for (int i = 0; i < cell_count(); ++i)
+        for (const Object& o : cell_at(i).objects) h += zobrist_key(i, o);
+    return h;
+}
+
+// -----------------------------------------------------------------------------
+//  Union des index des types de mask
+// -----------------------------------------------------------------------------
+CellSet Grid::cells_with(TypeMask types) const
+{
+    CellSet out;
+    out.clear();
+    for (TypeMask m = types; m; m &= m - 1) {
+        const CellSet& s = typeCells[(int)lowest_type(m)];
+        for (int w = 0; w < CellSet::WORDS; ++w) out.bits[w] |= s.bits[w];
+    }
+    return out;
+}
+
+// -----------------------------------------------------------------------------
+//  Première case (ordre de lecture) contenant un type de mask
+// -----------------------------------------------------------------------------
+int Grid::first_cell_with(TypeMask types) const
+{
+    int best = -1;
+    for (TypeMask m = types; m; m &= m - 1) {
+        int i = typeCells[(int)lowest_type(m)].first();
+        if (i >= 0 && (best < 0 || i < best)) best = i;
+    }
+    return best;
+}
+
+// -----------------------------------------------------------------------------
+//  Ajoute un objet au sommet d’une pile
+//  - Pile inline pleine → transfert dans un bloc de débordement libre.
+//  - Retourne false si la pile a atteint CELL_SPILL_CAP ou si le pool est vide.
+//  - Un type qui apparaît dans la case met à jour l’index typeCells et,
+//    s’il s’agit d’un mot, marque la ligne/colonne pour les règles.
+// -----------------------------------------------------------------------------
+bool Grid::stack_push(int index, Object o)
+{
+    CellSlot& s = slots[index];
+
+    if (s.spill == NO_SPILL) {
+        if (s.count < CELL_INLINE_CAP) {
+            s.inl[s.count++] = o;
+            hash += zobrist_key(index, o);
+            if (journal) journal->record_push(index, o);
+            type_added(index, o.type);
+            return true;
+        }
+
+        // Débordement : réserver un bloc et y déplacer la pile inline
+        if (spillUsed == 0xFFFFFFFFu) return false;
+        int b = __builtin_ctz(~spillUsed);
+        spillUsed |= (1u << b);
+        std::memcpy(spill[b].objs, s.inl, sizeof(s.inl));
+        s.spill = (uint8_t)b;
+    }
+
+    if (s.count >= CELL_SPILL_CAP) return false;
+    spill[s.spill].objs[s.count++] = o;
+    hash += zobrist_key(index, o);
+    if (journal) journal->record_push(index, o);
+    type_added(index, o.type);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+//  Place pour n objets de plus dans la case index
+//  - Pile limitée à CELL_SPILL_CAP ; une pile inline qui déborde doit
+//    trouver un bloc libre dans le pool (une pile débordée garde le sien).
+// -----------------------------------------------------------------------------
+bool Grid::stack_room(int index, int n) const
+{
+    const CellSlot& s = slots[index];
+    const int count = s.count + n;
+    if (count > CELL_SPILL_CAP) return false;
+    return count <= CELL_INLINE_CAP || s.spill != NO_SPILL || spillUsed != 0xFFFFFFFFu;
+}
+
+// -----------------------------------------------------------------------------
+//  Objet que le moteur n’a pas pu empiler (stack_push a échoué)
+//  - Compté dans overflowed ; seul le premier de la grille est signalé,
+//    pour ne pas inonder la console à chaque coup.
+// -----------------------------------------------------------------------------
+void Grid::stack_overflow(int index, Object o)
+{
+    if (overflowed++ == 0)
+        printf("[Grid] Case (%d, %d) pleine : objet %d perdu\n",
+               index % width, index / width, (int)o.type);
+}
+
+// -----------------------------------------------------------------------------
+//  Insère un objet à la position pos d’une pile (utilisé par l’annulation)
 // -----------------------------------------------------------------------------
-Cell& Grid::cell(int x, int y)
+bool Grid::stack_insert(int index, int pos, Object o)
 {
-    return cells[y * width + x];
+    if (!stack_push(index, o)) return false;
+
+    Object* data = stack_data(index);
+    int     n    = slots[index].count;
+    std::memmove(data + pos + 1, data + pos, (n - 1 - pos) * sizeof(Object));
+    data[pos] = o;
+    return true;
 }
 
 // -----------------------------------------------------------------------------
-//  Accès en lecture à une cellule
+//  Remplace l’objet pos d’une pile sans changer sa place (orientation,
+//  changement de type…). Journalisé comme un retrait suivi d’une insertion.
 // -----------------------------------------------------------------------------
-const Cell& Grid::cell(int x, int y) const
+void Grid::stack_replace(int index, int pos, Object o)
 {
-    return cells[y * width + x];
+    Object* data = stack_data(index);
+    const Object old = data[pos];
+
+    if (journal) {
+        journal->record_erase(index, pos, old);
+        journal->record_insert(index, pos, o);
+    }
+    hash += zobrist_key(index, o) - zobrist_key(index, old);
+    data[pos] = o;
+
+    if (o.type != old.type) {
+        type_added(index, o.type);
+        stack_shrunk(index);   // l’ancien type a pu disparaître
+    }
 }
 
 // -----------------------------------------------------------------------------
-//  draw_cell() — Dessine une cellule
+//  Un objet de type t vient d’être empilé dans la case index
+//  - La case est notée pour les effets même si le type y était déjà :
+//    un second objet suffit à déclencher SINK.
 // -----------------------------------------------------------------------------
+void Grid::type_added(int index, ObjectType t)
+{
+    effects.dirty.set(index);
+
+    TypeMask bit = type_bit(t);
+    if (cellTypes[index] & bit) return;   // type déjà présent : rien ne change
 
-void draw_cell(int x, int y, const Cell& c)
+    cellTypes[index] |= bit;
+    typeCells[(int)t].set(index);
+    if (bit & WORD_TYPES) mark_text_dirty(index);
+}
+
+// -----------------------------------------------------------------------------
+//  Supprime les objets [from, to) d’une pile (ordre conservé)
+// -----------------------------------------------------------------------------
+void Grid::stack_erase(int index, int from, int to)
+{
+    CellSlot& s = slots[index];
+    if (to <= from) return;
+
+    Object* data = stack_data(index);
+    for (int i = from; i < to; ++i) hash -= zobrist_key(index, data[i]);
+    if (journal) {
+        for (int i = to - 1; i >= from; --i) journal->record_erase(index, i, data[i]);
+    }
+    std::memmove(data + from, data + to, (s.count - to) * sizeof(Object));
+    s.count = (uint8_t)(s.count - (to - from));
+
+    stack_shrunk(index);
+}
+
+// -----------------------------------------------------------------------------
+//  Transfert en place d’une pile vers une autre
+//  - Empiler dans to ne déplace jamais la pile de from (cases distinctes) :
+//    les objets sont lus directement dans la pile source, puis retirés
+//    en une seule compaction.
+//  - Tout ou rien : la place est vérifiée avant le premier objet ; un objet
+//    n’est retiré de from que s’il a bien été empilé dans to.
+//  - dir >= 0 : la copie empilée porte cette orientation ; le journal garde
+//    l’objet d’origine au retrait, l’annulation le rend tel quel.
+// -----------------------------------------------------------------------------
+int Grid::stack_transfer(int from, int to, TypeMask types, int dir)
 {
-    for (auto& obj : c.objects) {
-        draw_sprite(x, y, obj.type); // appel clair et non ambigu
+    if (!(cellTypes[from] & types)) return 0;
+
+    const Object* src = stack_data(from);
+    const int     n   = slots[from].count;
+    int moving = 0;
+    for (int i = 0; i < n; ++i) moving += (type_bit(src[i].type) & types) != 0;
+    if (!stack_room(to, moving)) return -1;
+
+    uint32_t mask = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!(type_bit(src[i].type) & types)) continue;
+        const Object o = dir < 0 ? src[i] : Object{ src[i].type, (uint8_t)dir };
+        if (stack_push(to, o)) mask |= 1u << i;
+    }
+    stack_remove_mask(from, mask);
+    return __builtin_popcount(mask);
+}
+
+// -----------------------------------------------------------------------------
+//  Supprime les objets désignés par mask (bit i = objet i), ordre conservé
+// -----------------------------------------------------------------------------
+void Grid::stack_remove_mask(int index, uint32_t mask)
+{
+    CellSlot& s = slots[index];
+    Object* data = stack_data(index);
+
+    if (journal) {
+        for (int i = s.count - 1; i >= 0; --i)
+            if (mask & (1u << i)) journal->record_erase(index, i, data[i]);
+    }
+
+    int kept = 0;
+    for (int i = 0; i < s.count; ++i) {
+        if (!(mask & (1u << i))) data[kept++] = data[i];
+        else                     hash -= zobrist_key(index, data[i]);
+    }
+    s.count = (uint8_t)kept;
+
+    stack_shrunk(index);
+}
+
+// -----------------------------------------------------------------------------
+//  Mise à jour après suppression(s) dans une pile
+//  - Recalcule le masque de types de la case (pile de quelques objets).
+//  - Les types disparus sont retirés de l’index typeCells et la case est
+//    notée pour les effets (effects.dirty) ; si l’un d’eux est un mot, la
+//    ligne/colonne est marquée.
+//  - Une pile débordée qui repasse sous CELL_INLINE_CAP revient inline
+//    et libère son bloc.
+// -----------------------------------------------------------------------------
+void Grid::stack_shrunk(int index)
+{
+    CellSlot& s = slots[index];
+    Object* data = stack_data(index);
+
+    TypeMask m = 0;
+    for (int i = 0; i < s.count; ++i) m |= type_bit(data[i].type);
+
+    TypeMask gone = cellTypes[index] & ~m;
+    if (gone) {
+        cellTypes[index] = m;
+        for (TypeMask g = gone; g; g &= g - 1) typeCells[(int)lowest_type(g)].reset(index);
+        effects.dirty.set(index);
+        if (gone & WORD_TYPES) mark_text_dirty(index);
+    }
+
+    if (s.spill != NO_SPILL && s.count <= CELL_INLINE_CAP) {
+        std::memcpy(s.inl, data, s.count * sizeof(Object));
+        spillUsed &= ~(1u << s.spill);
+        s.spill = NO_SPILL;
     }
 }
 
@@ -13,6 +13,19 @@
     - La grille est volontairement générique : aucune logique de règles ici.
     - Le moteur de règles et le moteur de mouvement utilisent cette structure.
 
+  Stockage (arène plate) :
+    - Toute la carte tient dans un seul bloc contigu (Grid::slots) :
+      chaque case possède une petite pile inline de CELL_INLINE_CAP objets.
+    - Une pile qui déborde est transférée dans un bloc du pool de débordement
+      de la grille (Grid::spill), puis revient inline quand elle se vide.
+    - Aucune allocation dynamique : la grille est copiable par simple memcpy.
+    - cell(x,y) retourne une vue légère (Cell) sur la pile de la case.
+    - cellTypes[] garde, pour chaque case, le masque des types présents :
+      les tests de propriétés du moteur deviennent de simples ET.
+    - typeCells[] est l’index inverse (cases occupées par chaque type).
+    - hash est une empreinte 64 bits du contenu (Zobrist), tenue à jour
+      objet par objet : state_hash() ne reparcourt jamais la carte.
+
   Extensions prévues :
     - Support d’un système de couches (sol / objets / mots).
     - Support d’un système de z‑index pour le rendu.
@@ -24,8 +37,10 @@
 */
 
 #pragma once
-#include <vector>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include "vocabulary.h"
 
 namespace baba {
 
@@ -40,55 +55,203 @@ constexpr int MAP_SIZE   = MAP_WIDTH * MAP_HEIGHT;
 
 // -----------------------------------------------------------------------------
 //  Types d’objets du jeu
-//  (objets physiques + mots textuels)
+//  (objets physiques + mots textuels, générés depuis vocabulary.h)
 // -----------------------------------------------------------------------------
 enum class ObjectType : uint8_t {
-    Empty = 0,
-
-    // Objets physiques
-    Baba,
-    Wall,
-    Rock,
-    Flag,
-    Lava,
-    Goop,
-    Love,
-
-    // Mots (noms)
-    Text_Baba,
-    Text_Wall,
-    Text_Rock,
-    Text_Flag,
-    Text_Lava,
-    Text_Goop,
-    Text_Love,
-    Text_Empty,
-
-    // Mots (verbes / propriétés)
-    Text_Is,
-    Text_Push,
-    Text_Stop,
-    Text_Win,
-    Text_You,
-    Text_Sink,
-    Text_Kill,
-    Text_Swap,
-    Text_Hot,
-    Text_Melt,
-    Text_Move,
-    Text_Open,
-    Text_Shut,
-    Text_Float,
-
+#define BABA_OBJECT_ENUM(type, kind, object, prop, tile) type,
+    BABA_OBJECT_TYPES(BABA_OBJECT_ENUM)
+#undef BABA_OBJECT_ENUM
     Count
 };
 
+// Classe de chaque type (objet physique ou classe de mot), indexée par ObjectType
+constexpr WordKind OBJECT_KIND[(int)ObjectType::Count] = {
+#define BABA_OBJECT_KIND(type, kind, object, prop, tile) WordKind::kind,
+    BABA_OBJECT_TYPES(BABA_OBJECT_KIND)
+#undef BABA_OBJECT_KIND
+};
+
+
+// -----------------------------------------------------------------------------
+//  Masque de types (un bit par ObjectType)
+//  - Grid::cellTypes[i] = ensemble des types présents dans la case i.
+//  - Croisé avec PropertyTable::types_with(), il remplace les boucles sur
+//    les objets d’une case par un simple ET.
+// -----------------------------------------------------------------------------
+using TypeMask = uint64_t;
+static_assert((int)ObjectType::Count <= 64, "TypeMask trop petit pour ObjectType");
+
+constexpr TypeMask type_bit(ObjectType t) { return (TypeMask)1 << (int)t; }
+
+// Type du bit de poids faible d’un masque non vide
+inline ObjectType lowest_type(TypeMask m) { return (ObjectType)__builtin_ctzll(m); }
+
+// Masque des types d’une classe donnée
+constexpr TypeMask types_of_kind(WordKind k) {
+    TypeMask m = 0;
+    for (int i = 0; i < (int)ObjectType::Count; i++)
+        if (OBJECT_KIND[i] == k) m |= type_bit((ObjectType)i);
+    return m;
+}
+
+// Tous les mots TEXT_* (tout ce qui n’est pas un objet physique)
+constexpr TypeMask WORD_TYPES =
+    (((int)ObjectType::Count == 64 ? ~(TypeMask)0 : ((TypeMask)1 << (int)ObjectType::Count) - 1)
+     & ~types_of_kind(WordKind::Object));
+
+
+// -----------------------------------------------------------------------------
+//  Ensemble de cases (un bit par case, index = y * width + x)
+//  - Parcours en O(mots de 32 bits + éléments) via for_each().
+// -----------------------------------------------------------------------------
+struct CellSet {
+    static constexpr int WORDS = (MAP_SIZE + 31) / 32;
+    std::array<uint32_t, WORDS> bits;
+
+    void set(int i)        { bits[i >> 5] |=  (1u << (i & 31)); }
+    void reset(int i)      { bits[i >> 5] &= ~(1u << (i & 31)); }
+    bool test(int i) const { return (bits[i >> 5] >> (i & 31)) & 1u; }
+    void clear()           { bits.fill(0); }
+
+    // Premier index présent, ou -1 si l’ensemble est vide
+    int first() const {
+        for (int w = 0; w < WORDS; ++w)
+            if (bits[w]) return w * 32 + __builtin_ctz(bits[w]);
+        return -1;
+    }
+
+    template <class Fn> void for_each(Fn fn) const {
+        for (int w = 0; w < WORDS; ++w)
+            for (uint32_t m = bits[w]; m; m &= m - 1)
+                fn(w * 32 + __builtin_ctz(m));
+    }
+
+    // Parcours par index décroissant
+    template <class Fn> void for_each_reverse(Fn fn) const {
+        for (int w = WORDS - 1; w >= 0; --w)
+            for (uint32_t m = bits[w]; m; ) {
+                const int b = 31 - __builtin_clz(m);
+                m &= ~(1u << b);
+                fn(w * 32 + b);
+            }
+    }
+};
+
 
 // -----------------------------------------------------------------------------
 //  Objet individuel
 // -----------------------------------------------------------------------------
+// Orientation d’un objet (utilisée par MOVE). Codage du jeu original :
+// la direction opposée s’obtient par d ^ 2. Par défaut : vers la droite.
+enum Direction : uint8_t {
+    DIR_RIGHT = 0,
+    DIR_UP    = 1,
+    DIR_LEFT  = 2,
+    DIR_DOWN  = 3,
+};
+
+constexpr int       dir_dx(uint8_t d)       { return d == DIR_RIGHT ? 1 : d == DIR_LEFT ? -1 : 0; }
+constexpr int       dir_dy(uint8_t d)       { return d == DIR_DOWN  ? 1 : d == DIR_UP   ? -1 : 0; }
+constexpr Direction dir_opposite(uint8_t d) { return (Direction)(d ^ 2); }
+// Orientation d’un déplacement d’une case (dx, dy non nuls, pas de diagonale)
+constexpr Direction dir_of(int dx, int dy) {
+    return dx > 0 ? DIR_RIGHT : dx < 0 ? DIR_LEFT : dy < 0 ? DIR_UP : DIR_DOWN;
+}
+
 struct Object {
     ObjectType type;
+    uint8_t    dir = DIR_RIGHT;   // Direction
+};
+
+
+// -----------------------------------------------------------------------------
+//  Capacités du stockage (arène plate, sans allocation)
+// -----------------------------------------------------------------------------
+constexpr int     CELL_INLINE_CAP   = 4;    // objets rangés directement dans la case
+constexpr int     CELL_SPILL_CAP    = 32;   // taille max d’une pile (bloc de débordement)
+constexpr int     GRID_SPILL_BLOCKS = 32;   // blocs de débordement par grille (bitmask 32 bits)
+constexpr uint8_t NO_SPILL          = 0xFF; // la pile est inline
+
+// Emplacement d’une case dans l’arène
+struct CellSlot {
+    uint8_t count = 0;          // nombre d’objets dans la pile
+    uint8_t spill = NO_SPILL;   // index du bloc de débordement, ou NO_SPILL
+    Object  inl[CELL_INLINE_CAP];
+};
+
+// Bloc de débordement (pile d’une case trop chargée)
+struct SpillBlock {
+    Object objs[CELL_SPILL_CAP];
+};
+
+// -----------------------------------------------------------------------------
+//  Clé de Zobrist d’un objet de type t dans la case index
+//  - Calculée à la volée (mélange splitmix64) plutôt que lue dans une table
+//    de MAP_SIZE × Count entrées (~180 Ko).
+//  - Les clés sont additionnées (et non combinées par XOR) : deux objets
+//    identiques dans une même case ne s’annulent pas.
+// -----------------------------------------------------------------------------
+inline uint64_t hash_mix(uint64_t z)
+{
+    z *= 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+inline uint64_t zobrist_key(int index, Object o)
+{
+    // Orientation dans les bits 32+ : une orientation DIR_RIGHT (0) donne la
+    // même clé qu’un objet sans orientation. Pas fixe de 64 types par case :
+    // ajouter un type ne change pas les clés existantes
+    return hash_mix((uint64_t)(index * 64 + (int)o.type + 1)
+                    | (uint64_t)o.dir << 32);
+}
+
+struct Grid;
+class UndoJournal;
+
+
+// -----------------------------------------------------------------------------
+//  Pile d’objets d’une case (vue sur l’arène de la grille)
+//  - Interface proche de std::vector : size/empty/[]/begin/end/push_back/erase.
+//  - Les itérateurs sont des pointeurs : la pile est toujours contiguë.
+//  - Accès en lecture seule : toute modification passe par push_back/erase/
+//    remove_if, ce qui garde les caches de la grille (cellTypes) à jour.
+//  - push_back/erase peuvent déplacer la pile (inline <-> débordement) :
+//    utiliser la valeur de retour de erase() comme avec un vector.
+// -----------------------------------------------------------------------------
+class ObjectStack {
+public:
+    ObjectStack(Grid* g, int index) : grid_(g), index_(index) {}
+
+    int  size()  const;
+    bool empty() const { return size() == 0; }
+
+    const Object* begin() const;
+    const Object* end()   const { return begin() + size(); }
+
+    const Object& operator[](int i) const { return begin()[i]; }
+
+    // Types présents dans la pile (voir Grid::cellTypes)
+    TypeMask types() const;
+
+    // Ajoute un objet au sommet de la pile.
+    // Retourne false si la pile est pleine (CELL_SPILL_CAP) ou le pool épuisé.
+    bool push_back(Object o);
+
+    // Supprime un objet / une plage, retourne l’itérateur suivant
+    const Object* erase(const Object* it);
+    const Object* erase(const Object* first, const Object* last);
+
+    // Supprime tous les objets vérifiant pred (ordre des autres conservé)
+    template <class Pred> void remove_if(Pred pred);
+
+    void clear();
+
+private:
+    Grid* grid_;
+    int   index_;
 };
 
 
@@ -96,23 +259,109 @@ struct Object {
 //  Cellule de la grille (pile d’objets)
 // -----------------------------------------------------------------------------
 struct Cell {
-    std::vector<Object> objects;
+    ObjectStack objects;
 };
 
 
+// -----------------------------------------------------------------------------
+//  Effets de superposition en cours (YOU sur WIN, YOU sur KILL)
+//  - Tenus à jour par step() : seules les cases de dirty (objet ajouté ou
+//    type disparu) et celles des types dont les propriétés ont changé sont
+//    réévaluées (interactions SINK, HOT / MELT, OPEN / SHUT, puis WIN /
+//    KILL), pas toute la carte. Une case où des objets viennent d’être
+//    laissés (HAS) reste dans dirty pour le coup suivant.
+//  - Les masques de la dernière évaluation servent à détecter ce changement.
+// -----------------------------------------------------------------------------
+struct EffectState {
+    CellSet  dirty;           // cases modifiées depuis l’évaluation
+    CellSet  win;             // cases où un YOU touche un WIN
+    CellSet  death;           // cases où un YOU touche un KILL
+    int      winCount   = 0;
+    int      deathCount = 0;
+    TypeMask you = 0, wins = 0, deadly = 0;   // masques évalués
+    TypeMask sinks = 0, hots = 0, melts = 0, opens = 0, shuts = 0, floats = 0;
+    bool     cond = false;                    // règles conditionnelles évaluées
+
+    void clear() {
+        dirty.clear();
+        win.clear();
+        death.clear();
+        winCount = deathCount = 0;
+        you = wins = deadly = 0;
+        sinks = hots = melts = opens = shuts = floats = 0;
+        cond = false;
+    }
+};
+
 // -----------------------------------------------------------------------------
 //  Grille complète
 // -----------------------------------------------------------------------------
 
 struct Grid {
     int width, height;
-    std::vector<Cell> cells;
+
+    // Arène : une entrée par case (w×h ≤ MAP_SIZE) + pool de débordement
+    std::array<CellSlot, MAP_SIZE>            slots;
+    std::array<SpillBlock, GRID_SPILL_BLOCKS> spill;
+    uint32_t spillUsed = 0;   // bit i = bloc de débordement i occupé
+
+    // Objets perdus faute de place (pile pleine ou pool de débordement
+    // épuisé, voir stack_overflow()). Aucun niveau livré n’en approche :
+    // une valeur non nulle signale un niveau ou une règle hors capacité.
+    uint32_t overflowed = 0;
+
+    // Cache : types présents dans chaque case (mis à jour par push/erase)
+    std::array<TypeMask, MAP_SIZE> cellTypes;
+
+    // Index spatial : cases contenant au moins un objet de chaque type.
+    // Transposé de cellTypes ; sert à trouver les mots (TEXT_IS…) ou les
+    // objets YOU / MOVE sans parcourir la carte.
+    std::array<CellSet, (int)ObjectType::Count> typeCells;
+
+    // Lignes / colonnes où un type de mot est apparu ou a disparu depuis la dernière
+    // analyse des règles (bit y de dirtyRows, bit x de dirtyCols).
+    // Consommés et remis à zéro par rules_update().
+    uint32_t dirtyRows = 0;
+    uint32_t dirtyCols = 0;
+
+    // Effets de superposition, réévalués case par case (voir step())
+    EffectState effects;
+
+    // Empreinte du contenu : somme des zobrist_key() de tous les objets.
+    // Indépendante de l’ordre dans les piles ; mise à jour en O(1) par
+    // objet ajouté / retiré (stack_push / stack_erase…).
+    uint64_t hash = 0;
+
+    // Journal d’annulation (non possédé, nullptr = aucun). Une copie de la
+    // grille (solveur, état de secours…) doit remettre ce pointeur à nullptr.
+    UndoJournal* journal = nullptr;
 
     Grid(int w = MAP_WIDTH, int h = MAP_HEIGHT);
 
-    // Accès sécurisé aux cellules
-    Cell&       cell(int x, int y);
-    const Cell& cell(int x, int y) const;
+    // Vide la grille et change ses dimensions, sans réallocation
+    void reset(int w, int h);
+
+    // Accès aux cellules (vue sur la pile de la case)
+    Cell       cell(int x, int y)       { return Cell{ ObjectStack(this, y * width + x) }; }
+    const Cell cell(int x, int y) const { return Cell{ ObjectStack(const_cast<Grid*>(this), y * width + x) }; }
+
+    // Accès linéaire (index = y * width + x), pour les parcours complets
+    Cell       cell_at(int index)       { return Cell{ ObjectStack(this, index) }; }
+    const Cell cell_at(int index) const { return Cell{ ObjectStack(const_cast<Grid*>(this), index) }; }
+    int        cell_count() const       { return width * height; }
+
+    // Requêtes sur l’index : cases contenant au moins un type de mask
+    // (ex : props.types_with(PROP_YOU)). Coût proportionnel au nombre de
+    // types du masque, pas à la taille de la carte.
+    CellSet cells_with(TypeMask types) const;
+    int     first_cell_with(TypeMask types) const;   // -1 si aucune
+
+    // Empreinte de l’état : contenu + dimensions + zone jouable.
+    // Base de la détection d’états répétés, du solveur et des replays.
+    uint64_t state_hash() const;
+
+    // Recalcul complet de hash (référence pour les vérifications)
+    uint64_t compute_hash() const;
 
     // Vérifie si une coordonnée est dans la grille
     bool in_bounds(int x, int y) const;
@@ -124,13 +373,81 @@ struct Grid {
     bool in_play_area(int x, int y) const {
         return (x >= playMinX && x <= playMaxX && y >= playMinY && y <= playMaxY);
     }
+
+    // Primitives de stockage (utilisées par ObjectStack)
+    Object* stack_data(int index) {
+        CellSlot& s = slots[index];
+        return s.spill == NO_SPILL ? s.inl : spill[s.spill].objs;
+    }
+    const Object* stack_data(int index) const {
+        const CellSlot& s = slots[index];
+        return s.spill == NO_SPILL ? s.inl : spill[s.spill].objs;
+    }
+    bool stack_push(int index, Object o);            // false : pile pleine / pool épuisé
+    bool stack_room(int index, int n) const;         // n objets de plus tiennent dans la case
+    void stack_overflow(int index, Object o);        // objet perdu : compté, signalé une fois
+    void stack_erase(int index, int from, int to);   // supprime [from, to)
+    void stack_remove_mask(int index, uint32_t mask);// supprime les objets i (bit i)
+    bool stack_insert(int index, int pos, Object o); // insère à la position pos
+    void stack_replace(int index, int pos, Object o);// remplace l’objet pos, en place
+
+    // Déplace, de la case from vers la case to, tous les objets dont le type
+    // est dans types (ordre conservé). Sans allocation ni tampon : lecture
+    // directe dans la pile source. Retourne le nombre d’objets déplacés, ou
+    // -1 si la case to ne peut pas tous les recevoir (rien n’est déplacé).
+    // dir >= 0 : les objets déplacés prennent cette orientation (un seul
+    // retrait + ajout journalisé par objet, comme un déplacement simple).
+    int  stack_transfer(int from, int to, TypeMask types, int dir = -1);
+    void stack_shrunk(int index);                    // après suppression(s)
+    void type_added(int index, ObjectType t);        // après un ajout
+
+    // Marque la ligne et la colonne d’une case pour l’analyse des règles
+    void mark_text_dirty(int index) {
+        dirtyRows |= 1u << (index / width);
+        dirtyCols |= 1u << (index % width);
+    }
+    void mark_all_text_dirty() {
+        dirtyRows = (height >= 32) ? 0xFFFFFFFFu : ((1u << height) - 1);
+        dirtyCols = (width  >= 32) ? 0xFFFFFFFFu : ((1u << width)  - 1);
+    }
 };
+static_assert(MAP_WIDTH <= 32 && MAP_HEIGHT <= 32, "dirtyRows/dirtyCols sont des masques 32 bits");
 
 
-// ----------------------------------------------------------------------------- 
-// Fonctions utilitaires de rendu 
 // -----------------------------------------------------------------------------
-void draw_cell(int x, int y, const Cell& c);
+//  ObjectStack — accesseurs inline (chemin chaud du moteur)
+// -----------------------------------------------------------------------------
+inline int ObjectStack::size() const { return grid_->slots[index_].count; }
+
+inline const Object* ObjectStack::begin() const { return grid_->stack_data(index_); }
+
+inline TypeMask ObjectStack::types() const { return grid_->cellTypes[index_]; }
+
+inline bool ObjectStack::push_back(Object o) { return grid_->stack_push(index_, o); }
+
+inline const Object* ObjectStack::erase(const Object* it) { return erase(it, it + 1); }
+
+inline const Object* ObjectStack::erase(const Object* first, const Object* last)
+{
+    int from = (int)(first - begin());
+    grid_->stack_erase(index_, from, (int)(last - begin()));
+    return begin() + from;
+}
+
+template <class Pred>
+inline void ObjectStack::remove_if(Pred pred)
+{
+    static_assert(CELL_SPILL_CAP <= 32, "masque de suppression sur 32 bits");
+    const Object* data = begin();
+    const int     n    = size();
+    uint32_t mask = 0;
+    for (int i = 0; i < n; ++i) {
+        if (pred(data[i])) mask |= 1u << i;
+    }
+    if (mask) grid_->stack_remove_mask(index_, mask);
+}
+
+inline void ObjectStack::clear() { grid_->stack_erase(index_, 0, size()); }
 
 
 } // namespace baba
@@ -7,201 +7,664 @@
     - Gérer les chaînes de PUSH (ex : YOU → ROCK → ROCK → EMPTY).
     - Respecter STOP (bloque le mouvement).
     - Autoriser la superposition avec les objets non‑STOP (ex : FLAG).
-    - Appliquer les effets post‑mouvement (WIN, KILL, SINK).
+    - Résoudre les interactions (SINK, HOT / MELT, OPEN / SHUT, couches
+      FLOAT) puis les effets post‑mouvement (WIN, KILL), sur les seules
+      cases modifiées (voir resolve_cells()).
   Notes :
-    - La résolution des pushes est atomique : inspection -> suppression (SINK)
-      -> déplacement (tail -> head) -> déplacement de YOU -> recalcul règles.
+    - La résolution des pushes est atomique : inspection -> déplacement
+      (tail -> head) -> déplacement de YOU -> interactions -> recalcul règles.
+    - Les YOU sont résolus ensemble, du plus avancé au plus en retrait dans
+      le sens du coup (voir step()).
+    - Puis les objets MOVE avancent dans leur orientation, en un lot
+      (voir move_phase()).
 ===============================================================================
 */
 
 #include "movement.h"
-#include <algorithm>
+#include "undo.h"
+#include <atomic>
 #include <cstdio>   // pour debug temporaire si besoin
 
 namespace baba {
 
+// ============================================================================
+//  Masques de types utilisés pendant un step() (calculés une fois par coup)
+//  - Chaque test de propriété sur une case devient : grid.cellTypes[i] & masque
+//  - Avec des règles conditionnelles (ON), le masque dépend du contenu de la
+//    case : les accesseurs *_at() le recalculent (PropertyTable::types_at).
+//    Sans elles, ils rendent directement les masques du coup.
+// ============================================================================
+struct StepMasks {
+    const PropertyTable& props;
+    bool     cond;         // au moins une règle conditionnelle
+    TypeMask you, move, push, stop, win, sink, kill;   // types pouvant porter la propriété
+    TypeMask hot, melt, open, shut, flt;
+    TypeMask stopNoPush;   // STOP et non PUSH : bloque tout mouvement
+    TypeMask watch;        // types à revoir après le coup (YOU, interactions)
+
+    explicit StepMasks(const PropertyTable& p)
+        : props(p),
+          cond(p.condCount != 0),
+          you (p.types_any(PROP_YOU)),
+          move(p.types_any(PROP_MOVE)),
+          push(p.types_any(PROP_PUSH)),
+          stop(p.types_any(PROP_STOP)),
+          win (p.types_any(PROP_WIN)),
+          sink(p.types_any(PROP_SINK)),
+          kill(p.types_any(PROP_KILL)),
+          hot (p.types_any(PROP_HOT)),
+          melt(p.types_any(PROP_MELT)),
+          open(p.types_any(PROP_OPEN)),
+          shut(p.types_any(PROP_SHUT)),
+          flt (p.types_any(PROP_FLOAT)),
+          stopNoPush(stop & ~push),
+          watch(you | sink | hot | melt | open | shut) {}
+
+    TypeMask at(Property p, TypeMask here, TypeMask mask) const {
+        return cond ? props.types_at(p, here) : mask;
+    }
+    TypeMask you_at (TypeMask here) const { return at(PROP_YOU,  here, you);  }
+    TypeMask move_at(TypeMask here) const { return at(PROP_MOVE, here, move); }
+    TypeMask push_at(TypeMask here) const { return at(PROP_PUSH, here, push); }
+    TypeMask stop_at(TypeMask here) const { return at(PROP_STOP, here, stop); }
+    TypeMask win_at (TypeMask here) const { return at(PROP_WIN,  here, win);  }
+    TypeMask sink_at(TypeMask here) const { return at(PROP_SINK, here, sink); }
+    TypeMask kill_at(TypeMask here) const { return at(PROP_KILL, here, kill); }
+    TypeMask hot_at  (TypeMask here) const { return at(PROP_HOT,   here, hot);  }
+    TypeMask melt_at (TypeMask here) const { return at(PROP_MELT,  here, melt); }
+    TypeMask open_at (TypeMask here) const { return at(PROP_OPEN,  here, open); }
+    TypeMask shut_at (TypeMask here) const { return at(PROP_SHUT,  here, shut); }
+    TypeMask float_at(TypeMask here) const { return at(PROP_FLOAT, here, flt);  }
+    TypeMask stop_no_push_at(TypeMask here) const {
+        return cond ? stop_at(here) & ~push_at(here) : stopNoPush;
+    }
+
+    // Une interaction est possible dans une case de contenu here, de count
+    // objets (filtre rapide, couches non distinguées ; un objet seul ne
+    // réagit qu’avec lui-même : HOT et MELT, ou OPEN et SHUT)
+    bool may_react(TypeMask here, int count) const {
+        return ((here & sink) && count > 1) || ((here & hot) && (here & melt)) ||
+               ((here & open) && (here & shut));
+    }
+};
+
 // ============================================================================
 //  Helper : tente de pousser une chaîne d’objets d’une case (atomique)
 //  - startX/startY : première case contenant des objets (case directement devant YOU)
 //  - dx/dy : direction du push
-//  Retour : true si la chaîne a été poussée (ou la case finale vidée par SINK),
-//           false si le push est impossible (STOP, bord, case finale non libre).
+//  - stuck : cases (avec objets PUSH) dont on sait déjà, pendant ce coup,
+//            qu’elles ne peuvent pas avancer ; complété en cas d’échec
+//  - Une case de la chaîne peut mêler objets PUSH et non PUSH (ROCK sur
+//    FLAG) : seuls ses objets PUSH avancent, les autres restent. La chaîne
+//    s’arrête à la première case sans objet PUSH.
+//  - incoming : objets qui entreront dans la case de départ une fois la
+//               chaîne poussée (YOU, ou l’objet MOVE)
+//  Retour : true si la chaîne a été poussée (la case finale peut être occupée
+//           par des objets non STOP : SINK, HOT… réagissent après le coup),
+//           false si le push est impossible (STOP, bord, case d’arrivée
+//           pleine : voir chain_fits()).
+//  Aucune allocation : la chaîne (index de cases) tient dans un tampon fixe
+//  borné par la dimension de la carte, et les objets passent d’une pile à
+//  l’autre en place (Grid::stack_transfer).
 // ============================================================================
-static bool try_push_chain(Grid& grid, const PropertyTable& props,
-                           int startX, int startY, int dx, int dy)
+constexpr int MAX_CHAIN = (MAP_WIDTH > MAP_HEIGHT) ? MAP_WIDTH : MAP_HEIGHT;
+
+// Nombre d’objets de la case i dont le type est dans types
+static int count_types(const Grid& grid, int i, TypeMask types)
+{
+    if (!(grid.cellTypes[i] & types)) return 0;
+    const Object* objs = grid.stack_data(i);
+    int n = 0;
+    for (int k = 0; k < grid.slots[i].count; ++k) n += (type_bit(objs[k].type) & types) != 0;
+    return n;
+}
+
+// Place pour pousser la chaîne puis faire entrer incoming objets dans sa
+// première case : chaque case d’arrivée tient sous CELL_SPILL_CAP et le
+// pool fournit un bloc à chaque pile qui déborde (compte prudent : les
+// blocs libérés en cours de route ne sont pas repris). Vérifié avant le
+// premier transfert : un push est accepté en entier ou refusé.
+// Chemin courant (piles de quelques objets) : aucun comptage.
+enum ChainFit : uint8_t {
+    CHAIN_FITS,
+    CHAIN_FULL,   // une case d’arrivée de la chaîne est pleine : chaîne bloquée
+    START_FULL,   // seule la case de départ ne peut pas recevoir le mobile
+};
+
+static ChainFit chain_fits(const Grid& grid, const StepMasks& m, const int* chain, int len,
+                           int finalIndex, int start, int incoming)
+{
+    int blocks = 0;   // blocs de débordement à prendre
+    auto fits = [&](int cell, int count) {
+        if (count > CELL_SPILL_CAP) return false;
+        if (count > CELL_INLINE_CAP && grid.slots[cell].spill == NO_SPILL) blocks++;
+        return true;
+    };
+    auto moved = [&](int cell) { return count_types(grid, cell, m.push_at(grid.cellTypes[cell])); };
+
+    for (int i = 0; i < len; ++i) {
+        const int to = (i + 1 < len) ? chain[i + 1] : finalIndex;
+        if (grid.slots[to].count + grid.slots[chain[i]].count <= CELL_INLINE_CAP) continue;
+        const int left = grid.slots[to].count - ((i + 1 < len) ? moved(to) : 0);
+        if (!fits(to, left + moved(chain[i]))) return CHAIN_FULL;
+    }
+    const int spare = __builtin_popcount(~grid.spillUsed);
+    if (blocks > spare) return CHAIN_FULL;
+
+    if (grid.slots[start].count + incoming > CELL_INLINE_CAP) {
+        const int left = grid.slots[start].count - (len ? moved(start) : 0);
+        if (!fits(start, left + incoming) || blocks > spare) return START_FULL;
+    }
+    return CHAIN_FITS;
+}
+
+static bool try_push_chain(Grid& grid, const StepMasks& m, CellSet& stuck,
+                           int startX, int startY, int dx, int dy, int incoming)
 {
     int cx = startX;
     int cy = startY;
 
-    std::vector<std::pair<int,int>> chain;
+    // Case vide (cas le plus courant d’un coup) : rien à pousser, et les
+    // objets entrants tiennent dans la pile inline (bords vérifiés par
+    // l’appelant)
+    if (!grid.cellTypes[startY * grid.width + startX] && incoming <= CELL_INLINE_CAP)
+        return true;
 
-    // 1) Construire la chaîne (inspection seule)
-    while (grid.in_bounds(cx, cy) && grid.in_play_area(cx, cy)) {
-        Cell& c = grid.cell(cx, cy);
-        if (c.objects.empty()) break;
-
-        bool allPush = true;
-        for (auto& obj : c.objects) {
-            const Properties& pr = props[(int)obj.type];
-            // Si un objet STOP non pushable est présent -> blocage immédiat
-            if (pr.isStop && !pr.isPush) return false;
-            // Si un objet n'est pas pushable, on arrête la chaîne (on ne peut pas pousser)
-            if (!pr.isPush) { allPush = false; break; }
-        }
+    int chain[MAX_CHAIN];
+    int len = 0;
 
-        if (!allPush) break;
+    // Échec : toute la chaîne inspectée est bloquée pour le reste du coup
+    auto fail = [&]() {
+        for (int i = 0; i < len; ++i) stuck.set(chain[i]);
+        return false;
+    };
 
-        chain.emplace_back(cx, cy);
+    // 1) Construire la chaîne (inspection seule)
+    while (grid.in_bounds(cx, cy) && grid.in_play_area(cx, cy)) {
+        const int index = cy * grid.width + cx;
+        TypeMask types = grid.cellTypes[index];
+        if (!types) break;
+
+        // Si un objet STOP non pushable est présent -> blocage immédiat
+        if (types & m.stop_no_push_at(types)) return fail();
+        // Aucun objet pushable : fin de la chaîne (superposition)
+        if (!(types & m.push_at(types))) break;
+        // Suite de chaîne déjà résolue (bloquée) par un mobile situé devant
+        if (stuck.test(index)) return fail();
+
+        chain[len++] = index;
         cx += dx;
         cy += dy;
     }
 
     // Si la chaîne est vide, cela signifie que la case directement devant YOU
-    // contient des objets non-pushables. Dans ce cas, autoriser le mouvement
+    // ne contient aucun objet pushable. Dans ce cas, autoriser le mouvement
     // **si et seulement si** aucun de ces objets n'a la propriété STOP.
-    if (chain.empty()) {
-        Cell& target = grid.cell(startX, startY);
-        for (auto& obj : target.objects) {
-            const Properties& pr = props[(int)obj.type];
-            if (pr.isStop) return false; // case bloquée par STOP -> mouvement impossible
-        }
-        // Pas de STOP -> superposition autorisée (YOU peut entrer)
-        return true;
+    const int start = startY * grid.width + startX;
+    if (len == 0) {
+        // STOP -> case bloquée ; sinon superposition autorisée (YOU peut
+        // entrer), s’il y a la place
+        const TypeMask here = grid.cellTypes[start];
+        return (here & m.stop_at(here)) == 0 &&
+               chain_fits(grid, m, chain, 0, start, start, incoming) == CHAIN_FITS;
     }
 
     // 2) Vérifier la case finale (cx,cy) pour la chaîne non vide
-    if (!grid.in_bounds(cx, cy) || !grid.in_play_area(cx, cy)) return false;
+    if (!grid.in_bounds(cx, cy) || !grid.in_play_area(cx, cy)) return fail();
 
-    Cell& finalCell = grid.cell(cx, cy);
+    const int finalIndex = cy * grid.width + cx;
+    TypeMask finalTypes = grid.cellTypes[finalIndex];
 
-    // Si la case finale est vide -> ok
-    bool finalIsEmpty = finalCell.objects.empty();
+    // Case finale vide ou sans STOP -> ok (superposition, comme pour YOU)
+    if (finalTypes & m.stop_at(finalTypes)) return fail();
 
-    // Si la case finale contient des objets, autoriser uniquement si tous sont SINK
-    bool finalAllSink = true;
-    if (!finalIsEmpty) {
-        for (auto& obj : finalCell.objects) {
-            const Properties& pr = props[(int)obj.type];
-            if (!pr.isSink) { finalAllSink = false; break; }
-        }
-        if (!finalAllSink) return false; // case finale occupée par objet non-sink -> impossible
-    }
+    // Case d’arrivée pleine : la chaîne est bloquée comme par un STOP ;
+    // une case de départ pleine ne bloque que ce mobile
+    const ChainFit fit = chain_fits(grid, m, chain, len, finalIndex, start, incoming);
+    if (fit == CHAIN_FULL) return fail();
+    if (fit == START_FULL) return false;
 
-    // 3) Appliquer atomiquement :
-    if (!finalIsEmpty && finalAllSink) {
-        finalCell.objects.erase(
-            std::remove_if(finalCell.objects.begin(), finalCell.objects.end(),
-                           [&](const Object& o){ return props[(int)o.type].isSink; }),
-            finalCell.objects.end()
-        );
+    // 3) Déplacer la chaîne (tail -> head), pile à pile
+    const int delta = dy * grid.width + dx;
+    for (int i = len - 1; i >= 0; --i) {
+        grid.stack_transfer(chain[i], chain[i] + delta, m.push_at(grid.cellTypes[chain[i]]));
     }
 
-    // 4) Déplacer la chaîne (tail -> head)
-    for (int i = (int)chain.size() - 1; i >= 0; --i) {
-        int fromX = chain[i].first;
-        int fromY = chain[i].second;
-        int toX   = fromX + dx;
-        int toY   = fromY + dy;
+    return true;
+}
 
-        Cell& from = grid.cell(fromX, fromY);
-        Cell& to   = grid.cell(toX, toY);
 
-        std::vector<Object> moving;
-        for (auto& obj : from.objects) {
-            if (props[(int)obj.type].isPush) moving.push_back(obj);
-        }
+// ============================================================================
+//  Déplacement d’un objet (MOVE) d’une case dans la direction dir
+//  - Mêmes contrôles que pour YOU : bord, zone jouable, STOP, chaîne de PUSH.
+//  - Retourne false (rien n’a bougé) si le passage est bloqué.
+// ============================================================================
+static bool try_move_object(Grid& grid, const StepMasks& m, CellSet& stuck,
+                            int cell, int pos, uint8_t dir)
+{
+    const int dx = dir_dx(dir);
+    const int dy = dir_dy(dir);
+    const int nx = cell % grid.width + dx;
+    const int ny = cell / grid.width + dy;
+
+    if (!grid.in_bounds(nx, ny) || !grid.in_play_area(nx, ny)) return false;
+
+    const int target = ny * grid.width + nx;
+    if (grid.cellTypes[target] & m.stop_no_push_at(grid.cellTypes[target])) return false;
+    if (!try_push_chain(grid, m, stuck, nx, ny, dx, dy, 1)) return false;
+
+    // La case de départ n’a pas bougé : pos désigne toujours l’objet.
+    // La place a été vérifiée (chain_fits) ; par sécurité, un échec laisse
+    // le mobile sur place, rien n’est perdu
+    Object o = grid.stack_data(cell)[pos];
+    o.dir = dir;
+    if (!grid.stack_push(target, o)) return false;
+    grid.stack_erase(cell, pos, pos + 1);
+    return true;
+}
 
-        from.objects.erase(
-            std::remove_if(from.objects.begin(), from.objects.end(),
-                           [&](const Object& o){ return props[(int)o.type].isPush; }),
-            from.objects.end()
-        );
+// ============================================================================
+//  Phase MOVE — tous les objets MOVE avancent d’une case, en un seul lot
+//  - Relevé des mobiles par l’index (cells_with) : O(mobiles), pas O(carte).
+//    Un mobile = (case, type, orientation) ; deux objets identiques d’une
+//    même case sont interchangeables.
+//  - Traitement par orientation (droite, haut, gauche, bas), du plus avancé
+//    au plus en retrait, comme les YOU : chaque mobile est traité une fois.
+//  - Un mobile bloqué fait demi-tour et tente aussitôt la direction
+//    opposée ; bloqué des deux côtés, il reste sur place, retourné.
+//  - Un mobile déjà poussé ailleurs pendant la phase ne bouge plus ce coup-ci.
+//  - Au-delà de MAX_MOVERS mobiles (un relevé complet, ~4000 objets, ne
+//    tient pas dans la pile de la tâche de jeu), la phase se fait en lots
+//    successifs par index croissant ; une case ne change jamais de lot. Les
+//    cases où un lot a empilé des objets sont écartées des lots suivants :
+//    rien ne bouge deux fois, mais leurs mobiles restent sur place.
+// ============================================================================
+constexpr int MAX_MOVERS = 256;   // 1 Ko de pile (tâche de jeu : 8 Ko)
 
-        for (auto& mo : moving) to.objects.push_back(mo);
-    }
+struct Mover {
+    uint16_t   cell;
+    ObjectType type;
+    uint8_t    dir;
+};
 
-    return true;
+static void move_phase(Grid& grid, const StepMasks& m)
+{
+    Mover movers[MAX_MOVERS];
+    int   count = 0;
+
+    const CellSet cells = grid.cells_with(m.move);
+    CellSet stuck, reverse, filled;
+    filled.clear();
+    bool batched = false;
+
+    // Avance le mobile ; en lots, note les cases qui reçoivent des objets :
+    // sa case d’arrivée, la chaîne de PUSH poussée devant lui et la case
+    // finale (chaîne mesurée avant le déplacement)
+    auto advance = [&](const Mover& mv, int pos, uint8_t dir, CellSet& blocked) {
+        const int delta = dir_dy(dir) * grid.width + dir_dx(dir);
+        int len = 0;
+        if (batched) {
+            int x = mv.cell % grid.width, y = mv.cell / grid.width;
+            for (;;) {
+                x += dir_dx(dir);  y += dir_dy(dir);
+                if (!grid.in_bounds(x, y)) break;
+                const TypeMask t = grid.cellTypes[y * grid.width + x];
+                if (!(t & m.push_at(t))) break;
+                ++len;
+            }
+        }
+        if (!try_move_object(grid, m, blocked, mv.cell, pos, dir)) return false;
+        if (batched)
+            for (int k = 1; k <= len + 1; ++k) filled.set(mv.cell + k * delta);
+        return true;
+    };
+
+    auto resolve = [&](const Mover& mv) {
+        // Retrouver l’objet (sa position a pu changer dans la pile)
+        const Object* objs = grid.stack_data(mv.cell);
+        const int     n    = grid.slots[mv.cell].count;
+        int pos = 0;
+        while (pos < n && (objs[pos].type != mv.type || objs[pos].dir != mv.dir)) ++pos;
+        if (pos == n) return;
+
+        if (advance(mv, pos, mv.dir, stuck)) return;
+        stuck.set(mv.cell);
+
+        // Demi-tour : les cases bloquées vers l’avant ne disent rien de l’arrière
+        const uint8_t back = dir_opposite(mv.dir);
+        reverse.clear();
+        if (advance(mv, pos, back, reverse)) return;
+
+        Object o = objs[pos];
+        o.dir = back;
+        grid.stack_replace(mv.cell, pos, o);
+    };
+
+    for (int from = 0; from >= 0; ) {
+        // Relevé du lot : cases [from, next), une case entière ou rien
+        int next = -1;
+        count = 0;
+        cells.for_each([&](int i) {
+            if (i < from || next >= 0 || filled.test(i)) return;
+            const Object*  objs  = grid.stack_data(i);
+            const int      n     = grid.slots[i].count;
+            const TypeMask moves = m.move_at(grid.cellTypes[i]);
+            const int      start = count;
+            for (int k = 0; k < n; ++k) {
+                if (!(type_bit(objs[k].type) & moves)) continue;
+                if (count == MAX_MOVERS) { count = start; next = i; return; }
+                movers[count++] = Mover{ (uint16_t)i, objs[k].type, objs[k].dir };
+            }
+        });
+
+        // Lot partiel : les cases remplies par ce lot seront écartées
+        if (next >= 0 && !batched) {
+            static std::atomic<bool> warned{ false };
+            if (!warned.exchange(true))
+                printf("[Move] Plus de %d objets MOVE : phase traitée en lots\n", MAX_MOVERS);
+            batched = true;
+        }
+
+        // Relevé par index croissant : de l’avant vers l’arrière pour la gauche
+        // et le haut, en sens inverse pour la droite et le bas
+        for (uint8_t d = DIR_RIGHT; d <= DIR_DOWN; ++d) {
+            stuck.clear();
+            if (d == DIR_LEFT || d == DIR_UP) {
+                for (int k = 0; k < count; ++k)
+                    if (movers[k].dir == d) resolve(movers[k]);
+            } else {
+                for (int k = count - 1; k >= 0; --k)
+                    if (movers[k].dir == d) resolve(movers[k]);
+            }
+        }
+        from = next;
+    }
 }
 
 
 // ============================================================================
-//  step() — Applique un déplacement dx/dy à tous les objets YOU
-//  - Utilise try_push_chain pour garantir atomicité et gestion correcte de SINK
+//  Cases à réévaluer après le coup (interactions puis effets)
+//  - Une superposition ne dépend que du contenu de la case et des règles :
+//    on ne revoit que les cases modifiées (Grid::effects.dirty, tenu par la
+//    grille : coups, transformations, annulation…) et, si les règles ont
+//    changé, les cases des types dont une propriété concernée a changé.
+//  - Avec des règles conditionnelles (ON), toute case YOU (avant ou après)
+//    ou pouvant réagir est revue : la table ne dit pas quelles conditions
+//    ont changé.
 // ============================================================================
-MoveResult step(Grid& grid, const PropertyTable& props, int dx, int dy)
+static void collect_dirty(Grid& grid, const StepMasks& m)
 {
-    MoveResult result;
+    EffectState& e = grid.effects;
+
+    TypeMask changed = (m.you ^ e.you) | (m.win ^ e.wins) | (m.kill ^ e.deadly) |
+                       (m.sink ^ e.sinks) | (m.hot ^ e.hots) | (m.melt ^ e.melts) |
+                       (m.open ^ e.opens) | (m.shut ^ e.shuts) | (m.flt ^ e.floats);
+    if (m.cond || e.cond)
+        changed = m.you | e.you | m.sink | m.hot | m.melt | m.open | m.shut;
+    if (changed) {
+        const CellSet extra = grid.cells_with(changed);
+        for (int w = 0; w < CellSet::WORDS; ++w) e.dirty.bits[w] |= extra.bits[w];
+    }
+}
 
-    // 1) Snapshot des positions YOU au début
-    struct YouPos { int x, y; };
-    std::vector<YouPos> yous;
-    yous.reserve(grid.width * grid.height);
-
-    for (int y = 0; y < grid.height; ++y) {
-        for (int x = 0; x < grid.width; ++x) {
-            const Cell& c = grid.cell(x, y);
-            for (const auto& obj : c.objects) {
-                if (props[(int)obj.type].isYou) {
-                    yous.push_back({x, y});
-                }
-            }
+// ============================================================================
+//  Couches FLOAT : seuls les objets d’une même couche interagissent
+//  - Dans une case de contenu t, up = t & float_at(t) est la couche des
+//    objets FLOAT, t & ~up celle du sol ; un type est tout entier dans
+//    l’une ou l’autre.
+// ============================================================================
+static inline bool layers_meet(TypeMask t, TypeMask up, TypeMask a, TypeMask b)
+{
+    const TypeMask down = t & ~up;
+    return ((up & a) && (up & b)) || ((down & a) && (down & b));
+}
+
+// Types détruits dans la couche layer de la case i (contenu here)
+static TypeMask doomed_in_layer(Grid& grid, const StepMasks& m, int i,
+                                TypeMask here, TypeMask layer)
+{
+    if (!layer) return 0;
+    TypeMask doomed = 0;
+
+    // HOT / MELT : les objets MELT fondent au contact d’un objet HOT
+    if (layer & m.hot_at(here)) doomed |= layer & m.melt_at(here);
+
+    // OPEN / SHUT : s’annulent (un objet à la fois OPEN et SHUT aussi)
+    const TypeMask open = layer & m.open_at(here);
+    const TypeMask shut = layer & m.shut_at(here);
+    if (open && shut) doomed |= open | shut;
+
+    // SINK : coule avec tout ce qui partage sa couche (seul, il reste)
+    if (layer & m.sink_at(here)) {
+        int count = 2;
+        if (!(layer & (layer - 1))) {   // un seul type : compter ses objets
+            const Object* objs = grid.stack_data(i);
+            count = 0;
+            for (int k = 0; k < grid.slots[i].count; ++k)
+                count += (objs[k].type == lowest_type(layer));
         }
+        if (count > 1) doomed |= layer;
     }
+    return doomed;
+}
 
-    // 2) Pour chaque YOU, tenter de pousser la chaîne devant lui
-    for (const auto& yp : yous) {
-        int nx = yp.x + dx;
-        int ny = yp.y + dy;
+// ============================================================================
+//  Interactions d’une case — SINK, HOT / MELT, OPEN / SHUT, couches FLOAT
+//  - La case est résolue par intersection de masques (types de la couche &
+//    types portant la propriété) ; la pile n’est parcourue que si un type y
+//    est détruit.
+//  - Suppression en place (Grid::stack_remove_mask, journalisée). Les
+//    objets détruits laissent ce qu’ils possèdent (HAS) ; ceux-ci ne
+//    réagissent qu’au coup suivant, comme dans le jeu original : la case
+//    est notée dans again.
+//  - Retourne true si un objet YOU a été détruit.
+//  - Chemin rare, gardé hors de la boucle de resolve_cells() (noinline) :
+//    l’y intégrer coûte ~10 % sur un coup ordinaire.
+// ============================================================================
+__attribute__((noinline))
+static bool interact_cell(Grid& grid, const StepMasks& m, int i, TypeMask t, CellSet& again)
+{
+    const TypeMask up     = t & m.float_at(t);
+    const TypeMask doomed = doomed_in_layer(grid, m, i, t, up) |
+                            doomed_in_layer(grid, m, i, t, t & ~up);
+    if (!doomed) return false;
+
+    const Object* objs = grid.stack_data(i);
+    uint32_t mask  = 0;
+    Object   drops[CELL_SPILL_CAP];
+    int      count = 0;
+    for (int k = 0; k < grid.slots[i].count; ++k) {
+        if (!(type_bit(objs[k].type) & doomed)) continue;
+        mask |= 1u << k;
+        for (TypeMask h = m.props.holds[(int)objs[k].type]; h && count < CELL_SPILL_CAP; h &= h - 1)
+            drops[count++] = Object{ lowest_type(h), objs[k].dir };
+    }
 
-        // Bloquer hors grille / hors zone jouable
-        if (!grid.in_bounds(nx, ny)) continue;
-        if (!grid.in_play_area(nx, ny)) continue;
+    grid.stack_remove_mask(i, mask);
+    for (int k = 0; k < count; ++k)
+        if (!grid.stack_push(i, drops[k])) grid.stack_overflow(i, drops[k]);
+    if (count) again.set(i);
+    return (doomed & m.you_at(t)) != 0;
+}
 
-        // Vérifier STOP dans la case cible (si un objet STOP non-push y est, on bloque)
-        bool blocked = false;
-        for (auto& obj : grid.cell(nx, ny).objects) {
-            if (props[(int)obj.type].isStop && !props[(int)obj.type].isPush) { blocked = true; break; }
+// ============================================================================
+//  Passe post-mouvement — une seule passe sur les cases de effects.dirty
+//  (voir collect_dirty()) : interactions de la case, puis ses effets de
+//  superposition (WIN, KILL) sur son contenu final.
+//  - Les suppressions ne touchent que la case en cours : les autres cases
+//    de la passe ne changent pas.
+//  - Une case sans YOU ni type pouvant réagir est seulement retirée des
+//    ensembles win / death.
+//  - Un YOU ne gagne ou ne meurt qu’au contact d’un objet de sa couche.
+//  - Les ensembles win / death restent exacts d’un coup à l’autre :
+//    résultat identique à un parcours complet de la carte.
+//  - Retourne true si un objet YOU a été détruit.
+// ============================================================================
+static bool resolve_cells(Grid& grid, const StepMasks& m)
+{
+    EffectState& e = grid.effects;
+    bool    youLost = false;
+    bool    dropped = false;
+    CellSet again;
+
+    // Ajoute / retire la case i d’un ensemble en tenant son compte à jour
+    auto put = [](CellSet& set, int& count, int i, bool in) {
+        if (in == set.test(i)) return;
+        if (in) { set.set(i);   count++; }
+        else    { set.reset(i); count--; }
+    };
+
+    e.dirty.for_each([&](int i) {
+        TypeMask t = grid.cellTypes[i];
+        if (!(t & m.watch)) {
+            put(e.win,   e.winCount,   i, false);
+            put(e.death, e.deathCount, i, false);
+            return;
         }
-        if (blocked) continue;
-
-        // Essayer de pousser la chaîne devant (si PUSH)
-        // IMPORTANT : try_push_chain effectue l'inspection et applique les suppressions SINK
-        bool pushed = try_push_chain(grid, props, nx, ny, dx, dy);
-        if (!pushed) {
-            // push impossible -> ne pas déplacer ce YOU
-            continue;
+        if (m.may_react(t, grid.slots[i].count)) {
+            if (!dropped) { again.clear(); dropped = true; }
+            youLost |= interact_cell(grid, m, i, t, again);
+            t = grid.cellTypes[i];
         }
 
-        // 3) Déplacer YOU d’une case (superposition autorisée)
-        Cell& src = grid.cell(yp.x, yp.y);
-        Cell& dst = grid.cell(nx, ny);
+        const TypeMask you = t & m.you_at(t);
+        const TypeMask up  = you ? t & m.float_at(t) : 0;
+        put(e.win,   e.winCount,   i, you && layers_meet(t, up, you, m.win_at(t)));
+        put(e.death, e.deathCount, i, you && layers_meet(t, up, you, m.kill_at(t)));
+    });
+
+    // Cases où des objets ont été laissés : revues au coup suivant
+    if (dropped) e.dirty = again;
+    else         e.dirty.clear();
+
+    e.you    = m.you;
+    e.wins   = m.win;
+    e.deadly = m.kill;
+    e.sinks  = m.sink;
+    e.hots   = m.hot;
+    e.melts  = m.melt;
+    e.opens  = m.open;
+    e.shuts  = m.shut;
+    e.floats = m.flt;
+    e.cond   = m.cond;
+    return youLost;
+}
 
-        // Déplacer toutes les entités YOU présentes dans la cellule source
-        for (auto it = src.objects.begin(); it != src.objects.end(); ) {
-            if (props[(int)it->type].isYou) {
-                dst.objects.push_back(*it);
-                it = src.objects.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
 
-    // 4) Effets post-mouvement par superposition (WIN, KILL, SINK)
-    for (auto& cell : grid.cells) {
-        bool hasYou = false, hasWin = false, hasKill = false, hasSink = false;
-        for (auto& obj : cell.objects) {
-            const Properties& pr = props[(int)obj.type];
-            if (pr.isYou)  hasYou = true;
-            if (pr.isWin)  hasWin = true;
-            if (pr.isKill) hasKill = true;
-            if (pr.isSink) hasSink = true;
+// ============================================================================
+//  step() — Applique un déplacement dx/dy à tous les objets YOU
+//  - Résolution groupée : toutes les cases YOU sont relevées avant le coup,
+//    puis traitées de l’avant vers l’arrière dans le sens du déplacement
+//    (comme le jeu original). Un YOU ne peut donc jamais être déplacé deux
+//    fois, et le résultat ne dépend plus de l’ordre de parcours de la carte.
+//  - Une chaîne bloquée n’est parcourue qu’une fois : ses cases sont notées
+//    (stuck) et tout mobile situé derrière échoue dès qu’il les atteint.
+//    Rien ne change plus devant un mobile une fois qu’il a été traité.
+// ============================================================================
+MoveResult step(Grid& grid, const PropertyTable& props, int dx, int dy)
+{
+    MoveResult result;
+    const StepMasks m(props);
+
+    // Toutes les modifications du coup vont dans le même bloc du journal
+    if (grid.journal) grid.journal->begin_move();
+
+    // 1) Relevé des cases YOU au début (index par type : O(YOU), pas O(carte))
+    const CellSet yous = grid.cells_with(m.you);
+    const uint8_t dir  = dir_of(dx, dy);
+    CellSet stuck;
+    stuck.clear();
+
+    // 2) Pour chaque case YOU, tenter de pousser la chaîne devant elle
+    auto resolve = [&](int i) {
+        const TypeMask here = grid.cellTypes[i];
+        const TypeMask movers = here & m.you_at(here);
+        if (!movers) return;   // YOU conditionnel (ON) non satisfait ici
+
+        int x  = i % grid.width;
+        int y  = i / grid.width;
+        int nx = x + dx;
+        int ny = y + dy;
+
+        // Bloquer hors grille / hors zone jouable, ou si un objet STOP
+        // non-push occupe la case cible ; sinon essayer de pousser la chaîne
+        // devant
+        if (!grid.in_bounds(nx, ny) || !grid.in_play_area(nx, ny) ||
+            (grid.cellTypes[ny * grid.width + nx] & m.stop_no_push_at(grid.cellTypes[ny * grid.width + nx])) ||
+            !try_push_chain(grid, m, stuck, nx, ny, dx, dy, count_types(grid, i, movers))) {
+            // YOU reste en place : un mobile derrière ne pourra pas le pousser
+            stuck.set(i);
+            return;
         }
-        if (hasYou && hasWin) result.hasWon = true;
-        if (hasYou && (hasKill || hasSink)) result.hasDied = true;
+
+        // 3) Déplacer YOU d’une case (superposition autorisée) : toutes les
+        //    entités YOU de la case source passent dans la case cible (la
+        //    place a été vérifiée avec la chaîne). Elles prennent au passage
+        //    l’orientation du coup : un YOU qui est aussi MOVE continue dans
+        //    le sens où le joueur l’a déplacé (une attente, dx = dy = 0, ne
+        //    change rien)
+        grid.stack_transfer(i, ny * grid.width + nx, movers, (dx || dy) ? dir : -1);
+    };
+
+    // Index croissant = de l’avant vers l’arrière pour un coup vers la
+    // gauche / le haut ; décroissant pour la droite / le bas
+    if (dx < 0 || dy < 0) yous.for_each(resolve);
+    else                  yous.for_each_reverse(resolve);
+
+    // 4) Objets MOVE (après les YOU, comme dans le jeu original)
+    if (m.move) move_phase(grid, m);
+
+    // 5) Interactions (SINK, HOT / MELT, OPEN / SHUT) puis effets par
+    //    superposition (WIN, KILL) : seules les cases modifiées sont revues
+    collect_dirty(grid, m);
+    const bool youLost = resolve_cells(grid, m);
+    result.hasWon  = grid.effects.winCount  > 0;
+    result.hasDied = grid.effects.deathCount > 0 || youLost;
+
+    if (grid.journal) {
+        grid.journal->set_result((result.hasWon ? UNDO_WON : 0) | (result.hasDied ? UNDO_DIED : 0));
+        grid.journal->end_move();
     }
 
     return result;
 }
 
+// ============================================================================
+//  apply_transforms() — NOUN IS NOUN, passe groupée sur l’index par type
+//  - Les piles sont parcourues du sommet vers la base : une suppression ne
+//    décale que des objets déjà traités, et les copies ajoutées au sommet
+//    (divisions) ne sont jamais revisitées.
+// ============================================================================
+int apply_transforms(Grid& grid, const PropertyTable& props)
+{
+    constexpr TypeMask EMPTY_BIT = type_bit(ObjectType::Empty);
+
+    TypeMask sources = 0;
+    for (TypeMask t = props.transforms & ~EMPTY_BIT; t; t &= t - 1) {
+        const ObjectType s = lowest_type(t);
+        if (!(props.becomes[(int)s] & type_bit(s))) sources |= type_bit(s);   // X IS X : protégé
+    }
+    if (!sources) return 0;
+
+    int changed = 0;
+    grid.cells_with(sources).for_each([&](int i) {
+        for (int k = grid.slots[i].count - 1; k >= 0; --k) {
+            const Object o = grid.stack_data(i)[k];
+            if (!(type_bit(o.type) & sources)) continue;
+            changed++;
+
+            const TypeMask targets = props.becomes[(int)o.type] & ~EMPTY_BIT;
+            if (!targets) {                        // X IS EMPTY
+                grid.stack_erase(i, k, k + 1);
+                continue;
+            }
+            grid.stack_replace(i, k, Object{ lowest_type(targets), o.dir });
+            for (TypeMask t = targets & (targets - 1); t; t &= t - 1)
+                if (!grid.stack_push(i, Object{ lowest_type(t), o.dir }))
+                    grid.stack_overflow(i, Object{ lowest_type(t), o.dir });
+        }
+    });
+    return changed;
+}
+
 } // namespace baba
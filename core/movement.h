@@ -5,13 +5,20 @@
   Rôle :
     - Appliquer les déplacements des objets ayant la propriété YOU.
     - Gérer STOP, PUSH et les chaînes de PUSH.
-    - Détecter WIN, KILL, SINK après mouvement.
+    - Faire avancer les objets MOVE dans leur orientation (Object::dir),
+      avec demi-tour quand ils sont bloqués.
+    - Appliquer les transformations NOUN IS NOUN (apply_transforms).
+    - Résoudre les interactions après mouvement : SINK (détruit l’objet
+      et ce qui le recouvre), HOT / MELT, OPEN / SHUT ; seuls les objets
+      d’une même couche (FLOAT ou sol) interagissent.
+    - Détecter WIN, KILL après mouvement.
     - Retourner un MoveResult indiquant victoire ou mort.
+    - Si la grille a un journal (Grid::journal), y enregistrer le coup
+      pour l’annulation (voir undo.h).
 
   Notes :
     - Le moteur est volontairement minimal pour un prototype propre.
     - Extensions possibles :
-        * MOVE (déplacement automatique)
         * SHIFT (glissement)
         * TELE (téléportation)
         * PULL (tirer au lieu de pousser)
@@ -33,7 +40,8 @@ namespace baba {
   MoveResult — Résultat d’un déplacement
 -------------------------------------------------------------------------------
   Rôle :
-    - Indiquer si le mouvement a entraîné une victoire ou une mort.
+    - Indiquer si le mouvement a entraîné une victoire ou une mort
+      (YOU sur KILL, ou objet YOU détruit par une interaction).
 ===============================================================================
 */
 struct MoveResult {
@@ -46,25 +54,32 @@ struct MoveResult {
   Helpers pour tester les propriétés
 -------------------------------------------------------------------------------
   Rôle :
-    - Simplifier l’accès aux champs de Properties.
+    - Simplifier l’accès aux bits de Properties.
     - Utilisés par movement.cpp et potentiellement ailleurs.
 ===============================================================================
 */
-inline bool isYou(const Properties& p)   { return p.isYou; }
-inline bool isPush(const Properties& p)  { return p.isPush; }
-inline bool isStop(const Properties& p)  { return p.isStop; }
-inline bool isWin(const Properties& p)   { return p.isWin; }
-inline bool isSink(const Properties& p)  { return p.isSink; }
-inline bool isKill(const Properties& p)  { return p.isKill; }
+inline bool isYou(Properties p)   { return (p & PROP_YOU)  != 0; }
+inline bool isPush(Properties p)  { return (p & PROP_PUSH) != 0; }
+inline bool isStop(Properties p)  { return (p & PROP_STOP) != 0; }
+inline bool isWin(Properties p)   { return (p & PROP_WIN)  != 0; }
+inline bool isSink(Properties p)  { return (p & PROP_SINK) != 0; }
+inline bool isKill(Properties p)  { return (p & PROP_KILL) != 0; }
+inline bool isHot(Properties p)   { return (p & PROP_HOT)  != 0; }
+inline bool isMelt(Properties p)  { return (p & PROP_MELT) != 0; }
+inline bool isOpen(Properties p)  { return (p & PROP_OPEN) != 0; }
+inline bool isShut(Properties p)  { return (p & PROP_SHUT) != 0; }
+inline bool isFloat(Properties p) { return (p & PROP_FLOAT) != 0; }
 
 /*
 ===============================================================================
   step()
 -------------------------------------------------------------------------------
   Rôle :
-    - Appliquer un déplacement dx/dy à tous les objets YOU.
-    - Résoudre les PUSH.
-    - Appliquer les effets post-mouvement.
+    - Appliquer un déplacement dx/dy à tous les objets YOU, traités du
+      plus avancé au plus en retrait dans le sens du coup.
+    - Résoudre les PUSH (chaque chaîne bloquée n’est parcourue qu’une fois).
+    - Résoudre les interactions puis les effets post-mouvement, sur les
+      seules cases modifiées.
 
   Paramètres :
     - grid  : grille de jeu à modifier.
@@ -77,4 +92,29 @@ inline bool isKill(const Properties& p)  { return p.isKill; }
 */
 MoveResult step(Grid& grid, const PropertyTable& props, int dx, int dy);
 
+/*
+===============================================================================
+  apply_transforms()
+-------------------------------------------------------------------------------
+  Rôle :
+    - Appliquer les transformations NOUN IS NOUN (props.becomes) en une
+      passe de réécriture de types, sur les seules cases des types
+      concernés (index de la grille).
+
+  Règles (déterministes) :
+    - Chaque objet est transformé au plus une fois, d’après son type au
+      début de la passe : BABA IS ROCK + ROCK IS FLAG change les babas en
+      rochers et les rochers en drapeaux (pas de baba → drapeau).
+    - Plusieurs cibles : l’objet se divise, une copie par cible (la
+      première, par ordre de type, prend sa place dans la pile, les autres
+      vont au sommet), orientation conservée.
+    - X IS X protège X de toute transformation ; X IS EMPTY le supprime.
+
+  Retour :
+    - Nombre d’objets transformés. Les lignes/colonnes des mots touchés
+      sont marquées par la grille : rules_update() ne refait que celles-là.
+===============================================================================
+*/
+int apply_transforms(Grid& grid, const PropertyTable& props);
+
 } // namespace baba
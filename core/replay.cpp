@@ -0,0 +1,166 @@
+/*
+===============================================================================
+  replay.cpp — Implémentation du journal d’entrées
+-------------------------------------------------------------------------------
+  Rôle :
+    - Empaqueter les entrées (4 bits) et clore le journal.
+    - Sérialiser / relire un journal (.rec) octet par octet, sans dépendre
+      de l’alignement ni du boutisme de la machine.
+    - Appliquer une entrée au moteur (input_apply).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#include "replay.h"
+#include <cstdio>
+#include <cstring>
+
+namespace baba {
+
+static const char    REC_MAGIC[4] = { 'B', 'R', 'E', 'C' };
+static const uint8_t REC_VERSION  = 1;
+static const int     REC_HEADER   = 32;
+
+void input_log_begin(InputLog& log, int level, const Grid& g, int undoCapacity)
+{
+    log.level     = (uint8_t)level;
+    log.won       = false;
+    log.died      = false;
+    log.truncated = false;
+    log.count     = 0;
+    log.undoCap   = (uint32_t)undoCapacity;
+    log.startHash = g.state_hash();
+    log.endHash   = log.startHash;
+}
+
+void input_log_push(InputLog& log, InputCode c)
+{
+    if (log.count >= (uint32_t)INPUT_LOG_CAP) {
+        log.truncated = true;
+        return;
+    }
+    uint8_t& b = log.packed[log.count >> 1];
+    if (log.count & 1) b = (uint8_t)((b & 0x0F) | (c << 4));
+    else               b = (uint8_t)c;
+    log.count++;
+}
+
+void input_log_finish(InputLog& log, const Grid& g, bool won, bool died)
+{
+    log.endHash = g.state_hash();
+    log.won     = won;
+    log.died    = died;
+}
+
+// -----------------------------------------------------------------------------
+//  Sérialisation
+// -----------------------------------------------------------------------------
+static void put_u32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i)); }
+static void put_u64(uint8_t* p, uint64_t v) { for (int i = 0; i < 8; ++i) p[i] = (uint8_t)(v >> (8 * i)); }
+
+static uint32_t get_u32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+static uint64_t get_u64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+bool input_log_save(const InputLog& log, const char* path)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    uint8_t h[REC_HEADER];
+    std::memcpy(h, REC_MAGIC, 4);
+    h[4] = REC_VERSION;
+    h[5] = log.level;
+    h[6] = (uint8_t)((log.won ? 1 : 0) | (log.died ? 2 : 0) | (log.truncated ? 4 : 0));
+    h[7] = 0;
+    put_u32(h + 8,  log.count);
+    put_u32(h + 12, log.undoCap);
+    put_u64(h + 16, log.startHash);
+    put_u64(h + 24, log.endHash);
+
+    size_t body = (log.count + 1) / 2;
+    bool ok = fwrite(h, 1, REC_HEADER, f) == (size_t)REC_HEADER
+           && fwrite(log.packed.data(), 1, body, f) == body;
+    fclose(f);
+    return ok;
+}
+
+bool input_log_load(InputLog& log, const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+
+    uint8_t h[REC_HEADER];
+    bool ok = fread(h, 1, REC_HEADER, f) == (size_t)REC_HEADER
+           && std::memcmp(h, REC_MAGIC, 4) == 0
+           && h[4] == REC_VERSION;
+    if (ok) {
+        log.level     = h[5];
+        log.won       = (h[6] & 1) != 0;
+        log.died      = (h[6] & 2) != 0;
+        log.truncated = (h[6] & 4) != 0;
+        log.count     = get_u32(h + 8);
+        log.undoCap   = get_u32(h + 12);
+        log.startHash = get_u64(h + 16);
+        log.endHash   = get_u64(h + 24);
+
+        size_t body = (log.count + 1) / 2;
+        ok = log.count <= (uint32_t)INPUT_LOG_CAP
+          && fread(log.packed.data(), 1, body, f) == body;
+    }
+    fclose(f);
+    return ok;
+}
+
+// -----------------------------------------------------------------------------
+//  Application d’une entrée
+// -----------------------------------------------------------------------------
+MoveResult input_apply(Grid& g, RuleSet& rules, PropertyTable& props,
+                       UndoJournal* undo, InputCode c, RuleEvents* events)
+{
+    static const int DIRS[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+    MoveResult r;
+    if (events) events->clear();
+
+    switch (c) {
+        case INPUT_LEFT:
+        case INPUT_RIGHT:
+        case INPUT_UP:
+        case INPUT_DOWN:
+            // Un seul coup dans le journal : déplacement + transformations
+            if (g.journal) g.journal->begin_move();
+            r = step(g, props, DIRS[c][0], DIRS[c][1]);
+            rules_update(g, rules, props, events);
+            // NOUN IS NOUN, avec les règles d’après le déplacement ; les
+            // lignes ne sont réanalysées que si un mot a été transformé
+            if (apply_transforms(g, props)) rules_update(g, rules, props, events);
+            if (g.journal) g.journal->end_move();
+            return r;
+        case INPUT_UNDO:
+            if (!undo || !undo->undo(g)) return r;
+            break;
+        case INPUT_REDO: {
+            // Résultat du coup d’origine (noté dans le journal par step())
+            uint8_t result = 0;
+            if (!undo || !undo->redo(g, &result)) return r;
+            r.hasWon  = (result & UNDO_WON)  != 0;
+            r.hasDied = (result & UNDO_DIED) != 0;
+            break;
+        }
+    }
+
+    // Recalcul des règles : seules les lignes/colonnes où un mot a bougé
+    rules_update(g, rules, props, events);
+    return r;
+}
+
+} // namespace baba
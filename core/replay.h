@@ -0,0 +1,107 @@
+/*
+===============================================================================
+  replay.h — Enregistrement des entrées et rejeu déterministe
+-------------------------------------------------------------------------------
+  Rôle :
+    - Définir InputLog : journal compact des entrées appliquées pendant un
+      niveau (directions + undo/redo), 4 bits par entrée.
+    - Fournir input_apply() : LE chemin unique qui applique une entrée au
+      moteur (step + rules_update + transformations, ou undo/redo). game_update() et l’outil
+      de rejeu hôte l’utilisent tous les deux, ce qui garantit un rejeu
+      identique au jeu.
+    - Lire / écrire un journal dans un fichier (.rec).
+
+  Format de fichier (.rec, petit-boutiste) :
+      "BREC"   magic
+      u8       version (1)
+      u8       niveau (index dans le pack actif, levels_count())
+      u8       drapeaux : bit0 = victoire, bit1 = mort, bit2 = tronqué
+      u8       réservé
+      u32      nombre d’entrées
+      u32      capacité du journal d’annulation (entrées) pendant la partie
+      u64      empreinte de l’état initial (Grid::state_hash)
+      u64      empreinte de l’état final
+      …        entrées, deux par octet (poids faible d’abord)
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include "grid.h"
+#include "rules.h"
+#include "movement.h"
+#include "undo.h"
+
+namespace baba {
+
+// -----------------------------------------------------------------------------
+//  Entrées enregistrées (4 bits)
+// -----------------------------------------------------------------------------
+enum InputCode : uint8_t {
+    INPUT_LEFT  = 0,
+    INPUT_RIGHT = 1,
+    INPUT_UP    = 2,
+    INPUT_DOWN  = 3,
+    INPUT_UNDO  = 4,
+    INPUT_REDO  = 5,
+};
+
+// Direction → code (dx/dy non nuls, un seul axe)
+inline InputCode input_from_dir(int dx, int dy) {
+    if (dx < 0) return INPUT_LEFT;
+    if (dx > 0) return INPUT_RIGHT;
+    return dy < 0 ? INPUT_UP : INPUT_DOWN;
+}
+
+// -----------------------------------------------------------------------------
+//  Journal d’un niveau
+// -----------------------------------------------------------------------------
+constexpr int INPUT_LOG_CAP = 8192;   // entrées (4 Ko)
+
+struct InputLog {
+    uint8_t  level     = 0;
+    bool     won       = false;
+    bool     died      = false;
+    bool     truncated = false;   // journal plein : la fin de partie manque
+    uint32_t count     = 0;
+    uint32_t undoCap   = 0;       // capacité du journal d’annulation utilisé
+    uint64_t startHash = 0;
+    uint64_t endHash   = 0;
+    std::array<uint8_t, INPUT_LOG_CAP / 2> packed{};
+
+    InputCode at(int i) const {
+        return (InputCode)((packed[i >> 1] >> ((i & 1) * 4)) & 0x0F);
+    }
+};
+
+// Démarre un journal pour le niveau chargé dans g
+void input_log_begin(InputLog& log, int level, const Grid& g, int undoCapacity);
+
+// Ajoute une entrée (ignorée, et journal marqué tronqué, s’il est plein)
+void input_log_push(InputLog& log, InputCode c);
+
+// Clôt le journal sur l’état final
+void input_log_finish(InputLog& log, const Grid& g, bool won, bool died);
+
+// Fichier .rec : false si ouverture / lecture impossible ou format invalide
+bool input_log_save(const InputLog& log, const char* path);
+bool input_log_load(InputLog& log, const char* path);
+
+// -----------------------------------------------------------------------------
+//  Application d’une entrée (jeu et rejeu)
+//  - Direction : step() puis rules_update(), puis les transformations
+//    (apply_transforms) ; l’analyse n’est relancée que si un mot a changé.
+//    Le tout forme un seul coup dans le journal d’annulation.
+//  - UNDO / REDO : journal d’annulation (si présent) puis rules_update().
+//    Un REDO rend la victoire / la mort du coup rejoué (UndoResult).
+//  - events (facultatif) : vidé, puis rempli des règles apparues /
+//    disparues pendant cette entrée.
+// -----------------------------------------------------------------------------
+MoveResult input_apply(Grid& g, RuleSet& rules, PropertyTable& props,
+                       UndoJournal* undo, InputCode c, RuleEvents* events = nullptr);
+
+} // namespace baba
@@ -3,16 +3,36 @@
   rules.cpp — Implémentation du moteur de règles
 -------------------------------------------------------------------------------
   Rôle :
-    - Scanner la grille pour détecter les triplets (SUBJECT IS STATUS).
-    - Remplir la PropertyTable utilisée par le moteur de mouvement.
-    - Gérer les règles horizontales et verticales.
+    - Lire les phrases de la grille avec un automate à états fini piloté
+      par table : une suite de mots (horizontale ou verticale) est lue une
+      seule fois, de gauche à droite / de haut en bas.
+    - Grammaire reconnue :
+          [NOT] NOUN {AND [NOT] NOUN} [ON [NOT] NOUN {AND [NOT] NOUN}]
+              IS  [NOT] (STATUS | NOUN) {AND [NOT] (STATUS | NOUN)}
+              HAS [NOT] NOUN {AND [NOT] NOUN}
+    - Produire une liste compacte de règles (Rule), puis remplir la
+      PropertyTable utilisée par le moteur de mouvement.
+    - Ne lire que les suites contenant un verbe (IS / HAS), trouvées par
+      l’index spatial de la grille : O(mots), pas O(carte).
+    - Maintenir la liste des règles actives de façon incrémentale
+      (rules_update : seules les lignes/colonnes touchées sont réanalysées).
+
+  Notes :
+    - Un nom complément peut ouvrir la phrase suivante :
+      BABA IS ROCK IS PUSH = BABA IS ROCK + ROCK IS PUSH.
+    - Les mots d’une pile de même classe (deux noms, deux propriétés…)
+      participent tous ; une pile mêlant plusieurs classes coupe la suite.
+    - NOT l’emporte : BABA IS NOT YOU retire YOU quelles que soient les
+      autres règles.
 
   Limitations actuelles :
-    - Les règles "SUBJECT IS SUBJECT" (transformations) ne sont pas encore
-      appliquées ici. Elles seront traitées dans le moteur de gameplay.
-    - Les règles composées (ex : BABA IS YOU AND WIN) ne sont pas encore gérées.
-    - Les propriétés avancées (HOT/MELT, OPEN/SHUT, MOVE…) sont reconnues
-      mais pas encore appliquées dans movement.cpp.
+    - Les transformations (NOUN IS NOUN) sont appliquées par le moteur de
+      gameplay (apply_transforms, movement.cpp).
+    - La condition ON ne porte que sur les propriétés (pas sur les
+      transformations ni sur HAS) ; MAX_COND_RULES entrées au plus, les
+      règles de même condition et même propriété partageant une entrée.
+      Au-delà, la règle est ignorée (PropertyTable::condOverflow, signalé
+      une fois) : rules_parse() a la même limite, pas de repli possible.
 
   Auteur : Jean-Charles LEBEAU
   Date   : Janvier 2026
@@ -20,193 +40,549 @@
 */
 
 #include "rules.h"
+#include <atomic>
+#include <cstdio>
 
 namespace baba {
 
 // ============================================================================
-//  Classification des mots
+//  Tables du vocabulaire (générées depuis vocabulary.h à la compilation)
 // ============================================================================
-/*
-    is_word() :
-      Retourne true si le type correspond à un mot TEXT_*.
-*/
-bool is_word(ObjectType t) {
-    return t >= ObjectType::Text_Baba;
+// Nom → objet désigné (TEXT_ROCK → ROCK), indexé par ObjectType
+static constexpr ObjectType NOUN_OBJECT[(int)ObjectType::Count] = {
+#define BABA_NOUN_OBJECT(type, kind, object, prop, tile) ObjectType::object,
+    BABA_OBJECT_TYPES(BABA_NOUN_OBJECT)
+#undef BABA_NOUN_OBJECT
+};
+
+// Mot STATUS → bit de propriété (TEXT_PUSH → PROP_PUSH, 0 si aucun)
+static constexpr Properties WORD_PROPERTY[(int)ObjectType::Count] = {
+#define BABA_WORD_PROPERTY(type, kind, object, prop, tile) PROP_##prop,
+    BABA_OBJECT_TYPES(BABA_WORD_PROPERTY)
+#undef BABA_WORD_PROPERTY
+};
+
+static constexpr bool is_word(ObjectType t) {
+    return OBJECT_KIND[(int)t] != WordKind::Object;
 }
 
-/*
-    is_subject_word() :
-      Retourne true si le mot peut apparaître en position SUBJECT.
-      Exemple : TEXT_BABA, TEXT_ROCK, TEXT_FLAG…
-*/
-bool is_subject_word(ObjectType t) {
-    switch (t) {
-        case ObjectType::Text_Baba:
-        case ObjectType::Text_Wall:
-        case ObjectType::Text_Rock:
-        case ObjectType::Text_Flag:
-        case ObjectType::Text_Lava:
-        case ObjectType::Text_Goop:
-        case ObjectType::Text_Love:
-        case ObjectType::Text_Empty:
-            return true;
-        default:
-            return false;
-    }
+// Mot pouvant apparaître en position SUBJECT (TEXT_BABA, TEXT_ROCK…)
+static constexpr bool is_subject_word(ObjectType t) {
+    return OBJECT_KIND[(int)t] == WordKind::Noun;
 }
 
-/*
-    is_status_word() :
-      Retourne true si le mot peut apparaître en position STATUS.
-      Exemple : TEXT_PUSH, TEXT_STOP, TEXT_WIN…
-*/
-bool is_status_word(ObjectType t) {
-    switch (t) {
-        case ObjectType::Text_Push:
-        case ObjectType::Text_Stop:
-        case ObjectType::Text_Win:
-        case ObjectType::Text_You:
-        case ObjectType::Text_Sink:
-        case ObjectType::Text_Kill:
-        case ObjectType::Text_Swap:
-        case ObjectType::Text_Hot:
-        case ObjectType::Text_Melt:
-        case ObjectType::Text_Move:
-        case ObjectType::Text_Open:
-        case ObjectType::Text_Shut:
-        case ObjectType::Text_Float:
-            return true;
-        default:
-            return false;
-    }
+static constexpr ObjectType subject_to_object(ObjectType word) {
+    return NOUN_OBJECT[(int)word];
+}
+
+static constexpr Properties status_to_property(ObjectType s) {
+    return WORD_PROPERTY[(int)s];
 }
 
 // ============================================================================
-//  Conversion TEXT_BABA → BABA
+//  Réinitialise toutes les propriétés
 // ============================================================================
 /*
-    subject_to_object() :
-      Convertit un mot SUBJECT en son objet correspondant.
-      Exemple : TEXT_ROCK → ROCK.
+    rules_reset() :
+      Remet toutes les propriétés à zéro sauf les mots toujours déplaçables par défaut
 */
-ObjectType subject_to_object(ObjectType word) {
-    switch (word) {
-        case ObjectType::Text_Baba: return ObjectType::Baba;
-        case ObjectType::Text_Wall: return ObjectType::Wall;
-        case ObjectType::Text_Rock: return ObjectType::Rock;
-        case ObjectType::Text_Flag: return ObjectType::Flag;
-        case ObjectType::Text_Lava: return ObjectType::Lava;
-        case ObjectType::Text_Goop: return ObjectType::Goop;
-        case ObjectType::Text_Love: return ObjectType::Love;
-        case ObjectType::Text_Empty:return ObjectType::Empty;
-        default: return ObjectType::Empty;
-    }
+void rules_reset(PropertyTable& table) {
+    // Table par défaut construite une seule fois, puis simplement copiée
+    static const PropertyTable defaults = [] {
+        PropertyTable t;
+        // ✅ Les mots TEXT_* sont toujours PUSH
+        for (int i = 0; i < (int)ObjectType::Count; i++) {
+            if (is_word((ObjectType)i)) {
+                t.set((ObjectType)i, PROP_PUSH);
+            }
+        }
+        return t;
+    }();
+
+    table = defaults;
+}
+
+
+// ============================================================================
+//  Masques de mots (évalués à la compilation)
+// ============================================================================
+static constexpr TypeMask SUBJECT_WORDS = types_of_kind(WordKind::Noun);
+
+// Objets physiques : ce que désigne NOT BABA (tous sauf BABA)
+static constexpr TypeMask OBJECT_TYPES =
+    types_of_kind(WordKind::Object) & ~type_bit(ObjectType::Empty);
+
+// Toute phrase passe par un verbe : seules les suites qui en contiennent sont lues
+static constexpr TypeMask VERB_WORDS = type_bit(ObjectType::Text_Is) | type_bit(ObjectType::Text_Has);
+
+// Noms → objets (TEXT_BABA | TEXT_ROCK → BABA | ROCK) : les noms TEXT_BABA..
+// TEXT_LOVE suivent l’ordre des objets, un décalage suffit ; TEXT_EMPTY → EMPTY
+static constexpr int NOUN_SHIFT = (int)ObjectType::Text_Baba - (int)ObjectType::Baba;
+static_assert((int)ObjectType::Text_Love - (int)ObjectType::Love == NOUN_SHIFT,
+              "noms et objets doivent suivre le même ordre");
+
+static inline TypeMask nouns_to_objects(TypeMask nouns) {
+    constexpr TypeMask TEXT_EMPTY = type_bit(ObjectType::Text_Empty);
+    return ((nouns & ~TEXT_EMPTY) >> NOUN_SHIFT) |
+           ((nouns & TEXT_EMPTY) ? type_bit(ObjectType::Empty) : 0);
 }
 
+
 // ============================================================================
-//  Applique une propriété à un ensemble Properties
+//  Automate de lecture des phrases
 // ============================================================================
+// Classes de mots : entrées de l’automate (même ordre que WordKind)
+enum WordClass : uint8_t {
+    C_NOUN, C_PROP, C_IS, C_HAS, C_AND, C_NOT, C_ON,
+    C_COUNT,
+    C_BREAK = C_COUNT,   // case sans mot, ou pile mêlant plusieurs classes
+};
+static_assert((int)WordKind::On == C_ON && (int)WordKind::Object == C_BREAK,
+              "WordKind et WordClass doivent suivre le même ordre");
+
+// Mots de chaque classe, indexés par WordClass
+static constexpr std::array<TypeMask, C_COUNT> CLASS_WORDS = [] {
+    std::array<TypeMask, C_COUNT> m{};
+    for (int c = 0; c < C_COUNT; ++c) m[c] = types_of_kind((WordKind)c);
+    return m;
+}();
+
 /*
-    apply_status() :
-      Active un attribut dans la structure Properties.
-      Exemple : TEXT_PUSH → p.isPush = true.
+    word_class() :
+      Classe des mots d’une case : une lecture de table (classe du premier
+      mot) et un test de masque. Une pile de mots de même classe (deux
+      noms, deux propriétés…) compte comme un seul mot de cette classe.
 */
-void apply_status(Properties& p, ObjectType s) {
-    switch (s) {
-        case ObjectType::Text_You:  p.isYou=true; break;
-        case ObjectType::Text_Push: p.isPush=true; break;
-        case ObjectType::Text_Stop: p.isStop=true; break;
-        case ObjectType::Text_Win:  p.isWin=true; break;
-        case ObjectType::Text_Sink: p.isSink=true; break;
-        case ObjectType::Text_Kill: p.isKill=true; break;
-        case ObjectType::Text_Hot:  p.isHot=true; break;
-        case ObjectType::Text_Melt: p.isMelt=true; break;
-        case ObjectType::Text_Move: p.isMove=true; break;
-        case ObjectType::Text_Open: p.isOpen=true; break;
-        case ObjectType::Text_Shut: p.isShut=true; break;
-        case ObjectType::Text_Float:p.isFloat=true; break;
-        default: break;
+static inline uint8_t word_class(TypeMask words) {
+    if (!words) return C_BREAK;
+    const uint8_t c = (uint8_t)OBJECT_KIND[__builtin_ctzll(words)];
+    return (words & ~CLASS_WORDS[c]) ? (uint8_t)C_BREAK : c;
+}
+
+// États : position dans la phrase
+enum ParseState : uint8_t {
+    S_START,      // attend un sujet
+    S_SUBJ_NOT,   // NOT devant un sujet
+    S_SUBJ,       // sujet lu
+    S_SUBJ_AND,   // AND entre deux sujets
+    S_ON,         // ON : attend une condition
+    S_ON_NOT,     // ON NOT
+    S_COND,       // condition lue
+    S_IS,         // IS : attend un complément
+    S_IS_NOT,     // IS NOT
+    S_IS_COMP,    // complément de IS lu
+    S_HAS,        // HAS : attend un nom
+    S_HAS_NOT,    // HAS NOT
+    S_HAS_COMP,   // complément de HAS lu
+    S_COUNT,
+    S_FAIL = 0xFF
+};
+
+// Actions déclenchées par une transition
+enum ParseAction : uint8_t {
+    A_NONE,
+    A_NOT,       // bascule la négation du prochain nom / complément
+    A_SUBJECT,   // ajoute les noms de la case aux sujets
+    A_COND,      // ajoute les noms de la case à la condition ON
+    A_IS,        // verbe IS
+    A_HAS,       // verbe HAS
+    A_EMIT,      // émet une règle par mot complément de la case
+};
+
+struct Edge {
+    uint8_t next;
+    uint8_t action;
+};
+
+using FsmTable = std::array<std::array<Edge, C_COUNT>, S_COUNT>;
+
+static constexpr FsmTable make_fsm() {
+    FsmTable t{};
+    for (auto& row : t)
+        for (auto& e : row) e = Edge{ S_FAIL, A_NONE };   // transition invalide par défaut
+    auto on = [&t](uint8_t s, uint8_t c, uint8_t next, uint8_t action) {
+        t[s][c] = Edge{next, action};
+    };
+    on(S_START,    C_NOUN, S_SUBJ,     A_SUBJECT);
+    on(S_START,    C_NOT,  S_SUBJ_NOT, A_NOT);
+    on(S_SUBJ_NOT, C_NOUN, S_SUBJ,     A_SUBJECT);
+    on(S_SUBJ_NOT, C_NOT,  S_SUBJ_NOT, A_NOT);
+    on(S_SUBJ,     C_AND,  S_SUBJ_AND, A_NONE);
+    on(S_SUBJ,     C_ON,   S_ON,       A_NONE);
+    on(S_SUBJ,     C_IS,   S_IS,       A_IS);
+    on(S_SUBJ,     C_HAS,  S_HAS,      A_HAS);
+    on(S_SUBJ_AND, C_NOUN, S_SUBJ,     A_SUBJECT);
+    on(S_SUBJ_AND, C_NOT,  S_SUBJ_NOT, A_NOT);
+    on(S_ON,       C_NOUN, S_COND,     A_COND);
+    on(S_ON,       C_NOT,  S_ON_NOT,   A_NOT);
+    on(S_ON_NOT,   C_NOUN, S_COND,     A_COND);
+    on(S_ON_NOT,   C_NOT,  S_ON_NOT,   A_NOT);
+    on(S_COND,     C_AND,  S_ON,       A_NONE);
+    on(S_COND,     C_IS,   S_IS,       A_IS);
+    on(S_COND,     C_HAS,  S_HAS,      A_HAS);
+    on(S_IS,       C_NOUN, S_IS_COMP,  A_EMIT);
+    on(S_IS,       C_PROP, S_IS_COMP,  A_EMIT);
+    on(S_IS,       C_NOT,  S_IS_NOT,   A_NOT);
+    on(S_IS_NOT,   C_NOUN, S_IS_COMP,  A_EMIT);
+    on(S_IS_NOT,   C_PROP, S_IS_COMP,  A_EMIT);
+    on(S_IS_NOT,   C_NOT,  S_IS_NOT,   A_NOT);
+    on(S_IS_COMP,  C_AND,  S_IS,       A_NONE);
+    on(S_HAS,      C_NOUN, S_HAS_COMP, A_EMIT);
+    on(S_HAS,      C_NOT,  S_HAS_NOT,  A_NOT);
+    on(S_HAS_NOT,  C_NOUN, S_HAS_COMP, A_EMIT);
+    on(S_HAS_NOT,  C_NOT,  S_HAS_NOT,  A_NOT);
+    on(S_HAS_COMP, C_AND,  S_HAS,      A_NONE);
+    return t;
+}
+
+static constexpr FsmTable FSM = make_fsm();
+
+// Phrase en cours de lecture
+struct Sentence {
+    TypeMask subjects = 0;
+    TypeMask onAll    = 0;
+    TypeMask onNone   = 0;
+    uint8_t  verb     = 0;       // 0 (IS) ou RULE_HAS
+    bool     negated  = false;   // NOT en attente
+};
+
+/*
+    parse_run() :
+      Lit la suite de mots qui commence à la case start (pas stride, au plus
+      n cases) et émet ses règles. S’arrête à la première case qui n’est pas
+      un mot ; retourne le nombre de cases lues.
+
+      Une seule passe : sur une transition invalide, la phrase en cours est
+      abandonnée et la lecture reprend à la case courante, avec le nom de la
+      case précédente comme sujet s’il y en a un (BABA IS ROCK IS PUSH).
+*/
+template <class Emit>
+static int parse_run(const Grid& g, int start, int stride, int n,
+                     uint8_t vertical, uint8_t line, Emit emit)
+{
+    Sentence s;
+    uint8_t  state     = S_START;
+    TypeMask prevNouns = 0;   // noms de la case précédente
+
+    int k = 0;
+    for (; k < n; ++k) {
+        const TypeMask words = g.cellTypes[start + k * stride] & WORD_TYPES;
+        const uint8_t  c     = word_class(words);
+        if (c == C_BREAK) break;
+
+        Edge e = FSM[state][c];
+        if (e.next == S_FAIL) {
+            s = Sentence{};
+            state = S_START;
+            if (prevNouns) {
+                s.subjects = nouns_to_objects(prevNouns);
+                e = FSM[S_SUBJ][c];
+                if (e.next == S_FAIL) s = Sentence{};
+            }
+            if (e.next == S_FAIL) e = FSM[S_START][c];
+        }
+        prevNouns = (c == C_NOUN) ? words : 0;
+        if (e.next == S_FAIL) continue;
+
+        switch (e.action) {
+            case A_NOT:
+                s.negated = !s.negated;
+                break;
+            case A_SUBJECT: {
+                const TypeMask objs = nouns_to_objects(words);
+                s.subjects |= s.negated ? (OBJECT_TYPES & ~objs) : objs;
+                s.negated = false;
+                break;
+            }
+            case A_COND:
+                (s.negated ? s.onNone : s.onAll) |= nouns_to_objects(words);
+                s.negated = false;
+                break;
+            case A_IS:
+                s.verb = 0;
+                break;
+            case A_HAS:
+                s.verb = RULE_HAS;
+                break;
+            case A_EMIT: {
+                const uint8_t flags = s.verb | (s.negated ? RULE_NOT : 0);
+                for (TypeMask m = words; m && s.subjects; m &= m - 1)
+                    emit(Rule{ s.subjects, s.onAll, s.onNone, lowest_type(m), flags, vertical, line });
+                s.negated = false;
+                break;
+            }
+            default:
+                break;
+        }
+        state = e.next;
     }
+    return k;
 }
 
-// ============================================================================
-//  Réinitialise toutes les propriétés
-// ============================================================================
 /*
-    rules_reset() :
-      Remet toutes les propriétés à false sauf les mots toujours déplaçables par défaut
+    scan_lines() :
+      Lit les suites de mots des lignes rows et des colonnes cols (masques
+      de bits) qui contiennent un verbe. Les verbes sont visités dans l’ordre
+      de lecture ; pour chacun (s’il a un mot de chaque côté), on remonte au
+      début de sa suite puis on la lit jusqu’au bout. Une suite à plusieurs verbes n’est lue qu’une fois
+      (fin de la dernière suite lue, par ligne et par colonne).
 */
-void rules_reset(PropertyTable& table) {
-    for (size_t i = 0; i < table.size(); i++) {
-        table[i] = Properties{};
+template <class Emit>
+static void scan_lines(const Grid& g, uint32_t rows, uint32_t cols, Emit emit)
+{
+    const int w = g.width;
+    const int h = g.height;
+    std::array<uint8_t, MAP_HEIGHT> rowEnd{};
+    std::array<uint8_t, MAP_WIDTH>  colEnd{};
 
-        // ✅ Les mots TEXT_* sont toujours PUSH
-        if (is_word((ObjectType)i)) {
-            table[i].isPush = true;
+    auto is_word_cell = [&](int i) {
+        return word_class(g.cellTypes[i] & WORD_TYPES) != C_BREAK;
+    };
+
+    g.cells_with(VERB_WORDS).for_each([&](int i) {
+        const int x = i % w;
+        const int y = i / w;
+
+        // Un verbe sans mot de part et d’autre ne porte aucune phrase
+        if (((rows >> y) & 1u) && x >= rowEnd[y] &&
+            x > 0 && x < w - 1 && is_word_cell(i - 1) && is_word_cell(i + 1)) {
+            int x0 = x;
+            while (x0 > 0 && is_word_cell(i - (x - x0) - 1)) --x0;
+            rowEnd[y] = (uint8_t)(x0 + parse_run(g, y * w + x0, 1, w - x0, 0, (uint8_t)y, emit));
+        }
+        if (((cols >> x) & 1u) && y >= colEnd[x] &&
+            y > 0 && y < h - 1 && is_word_cell(i - w) && is_word_cell(i + w)) {
+            int y0 = y;
+            while (y0 > 0 && is_word_cell(i - (y - y0 + 1) * w)) --y0;
+            colEnd[x] = (uint8_t)(y0 + parse_run(g, y0 * w + x, w, h - y0, 1, (uint8_t)x, emit));
         }
+    });
+}
+
+
+// ============================================================================
+//  Application des règles à la table
+// ============================================================================
+// Négation d’une transformation / possession : retire des bits, donc doit
+// passer après les règles positives (les négations de propriété, elles,
+// sont indépendantes de l’ordre : PropertyTable::deny)
+static inline bool applies_late(const Rule& r) {
+    return (r.flags & RULE_NOT) && is_subject_word(r.word) && !(r.onAll | r.onNone);
+}
+
+// Applique une règle à la table (les mots STATUS sans effet sont ignorés)
+static void apply_rule(PropertyTable& table, const Rule& r) {
+    const bool negated = r.flags & RULE_NOT;
+
+    if (r.onAll | r.onNone) {
+        const Properties p = (r.flags & RULE_HAS) ? 0 : status_to_property(r.word);
+        if (p && !table.add_cond(CondRule{ r.subjects, r.onAll, r.onNone, p, (uint8_t)negated })) {
+            static std::atomic<bool> warned{ false };
+            if (!warned.exchange(true))
+                printf("[Rules] Plus de %d règles conditionnelles : règle ignorée\n", MAX_COND_RULES);
+        }
+        return;
+    }
+
+    if (is_subject_word(r.word)) {
+        const ObjectType target = subject_to_object(r.word);
+        for (TypeMask m = r.subjects; m; m &= m - 1) {
+            const ObjectType t = lowest_type(m);
+            if (r.flags & RULE_HAS) {
+                if (negated) table.holds[(int)t] &= ~type_bit(target);
+                else         table.holds[(int)t] |=  type_bit(target);
+            }
+            else if (negated) table.unset_becomes(t, target);
+            else              table.set_becomes(t, target);
+        }
+        return;
+    }
+
+    const Properties p = (r.flags & RULE_HAS) ? 0 : status_to_property(r.word);
+    if (!p) return;
+    for (TypeMask m = r.subjects; m; m &= m - 1) {
+        if (negated) table.deny(lowest_type(m), (Property)p);
+        else         table.set(lowest_type(m), (Property)p);
     }
 }
 
+// Reconstruit la table à partir d’une liste de règles
+static void build_table(PropertyTable& table, const RuleSet& set) {
+    rules_reset(table);
+    bool late = false;
+    for (int i = 0; i < set.count; i++) {
+        if (applies_late(set.rules[i])) late = true;
+        else                            apply_rule(table, set.rules[i]);
+    }
+    if (late)
+        for (int i = 0; i < set.count; i++)
+            if (applies_late(set.rules[i])) apply_rule(table, set.rules[i]);
+    table.finish();
+}
+
 
 // ============================================================================
-//  Analyse la grille et extrait les règles actives
+//  Analyse complète de la grille
 // ============================================================================
 /*
     rules_parse() :
-      Parcourt la grille pour détecter les triplets :
-          SUBJECT — IS — STATUS
-
-      Deux scans :
-        - horizontal : (x,y), (x+1,y), (x+2,y)
-        - vertical   : (x,y), (x,y+1), (x,y+2)
+      Lit toutes les suites de mots contenant un verbe, horizontales et
+      verticales, et applique directement les règles à la table.
 
       Exemple :
         BABA IS YOU
-        ROCK IS PUSH
-        FLAG IS WIN
+        ROCK AND WALL IS PUSH
+        FLAG IS WIN AND NOT STOP
 
-      Les propriétés détectées sont stockées dans table[subj].
+      Sert de référence à rules_update().
 */
 void rules_parse(const Grid& g, PropertyTable& table) {
     rules_reset(table);
 
-    int w = g.width;
-    int h = g.height;
+    bool late = false;
+    scan_lines(g, ~0u, ~0u, [&](const Rule& r) {
+        if (applies_late(r)) late = true;
+        else                 apply_rule(table, r);
+    });
+    if (late)
+        scan_lines(g, ~0u, ~0u, [&](const Rule& r) {
+            if (applies_late(r)) apply_rule(table, r);
+        });
+    table.finish();
+}
 
-    // Fonction locale pour traiter un triplet
-    auto process = [&](ObjectType a, ObjectType b, ObjectType c){
-        if (b != ObjectType::Text_Is) return;
-        if (!is_subject_word(a)) return;
 
-        ObjectType subj = subject_to_object(a);
+// ============================================================================
+//  Événements de règles
+// ============================================================================
+void RuleEvents::push(RuleEventKind kind, const Rule& r) {
+    for (int i = 0; i < count; i++) {
+        if (!same_rule(events[i].rule, r)) continue;
+        if (events[i].kind != kind) {          // apparue puis disparue (ou l’inverse)
+            for (int k = i + 1; k < count; k++) events[k - 1] = events[k];
+            count--;
+        }
+        return;
+    }
+    if (count < MAX_RULE_EVENTS) events[count++] = RuleEvent{ r, kind };
+    else                         overflow = true;
+}
+
+void RuleEvents::prune(const RuleSet& set) {
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        bool active = false;
+        for (int k = 0; k < set.count && !active; k++) active = same_rule(set.rules[k], events[i].rule);
+        if (active == (events[i].kind == RuleEventKind::Added)) events[kept++] = events[i];
+    }
+    count = (uint8_t)kept;
+}
+
+
+// ============================================================================
+//  Analyse incrémentale
+// ============================================================================
+/*
+    rules_update() :
+      Une phrase horizontale est entièrement contenue dans une ligne, une
+      phrase verticale dans une colonne. Quand un mot entre ou sort d’une
+      case (x,y), seules les phrases de la ligne y et de la colonne x peuvent
+      changer (marquées par la grille dans dirtyRows / dirtyCols).
 
-        if (is_status_word(c))
-            apply_status(table[(size_t)subj], c);
+      Étapes :
+        1. Relire uniquement les suites situées sur ces lignes/colonnes,
+           à la suite de la liste (qui reste intacte à ce stade).
+        2. Retirer de la liste les règles portées par une ligne/colonne
+           sale, et ramener les règles relues derrière celles conservées.
+        3. Reconstruire la table à partir de la liste (quelques règles).
+
+      Si la relecture ne tient pas derrière la liste mais tiendrait une
+      fois les règles sales retirées (liste presque pleine, rare), elle est
+      refaite après l’étape 2. Au-delà de MAX_RULES règles, on retombe sur
+      rules_parse() pour la table, la liste n’est pas touchée et tout sera
+      réanalysé au prochain appel : le résultat reste exact.
+
+      Événements : différence entre l’ancienne liste et la nouvelle, au
+      sens de same_rule(), calculée pendant la relecture (l’ancienne liste
+      est encore intacte). En cas de débordement, les événements du coup
+      sont effacés et events->overflow est levé ; la liste gardée est celle
+      d’avant le débordement, et la reconstruction complète qui suit ne
+      signale donc que les règles réellement apparues ou disparues
+      entre-temps.
+*/
+bool rules_update(Grid& g, RuleSet& set, PropertyTable& table, RuleEvents* events) {
+    uint32_t rows = g.dirtyRows;
+    uint32_t cols = g.dirtyCols;
+    if (!rows && !cols) return false;
+
+    auto on_dirty_line = [&](const Rule& r) {
+        return ((r.vertical ? cols : rows) >> r.line) & 1u;
     };
 
-    // -------------------------------------------------------------------------
-    // Scan horizontal
-    // -------------------------------------------------------------------------
-    for (int y=0; y<h; y++)
-        for (int x=0; x<w-2; x++) {
-            auto& c0 = g.cell(x,y).objects;
-            auto& c1 = g.cell(x+1,y).objects;
-            auto& c2 = g.cell(x+2,y).objects;
-            if (c0.empty() || c1.empty() || c2.empty()) continue;
-            process(c0[0].type, c1[0].type, c2[0].type);
+    // 1) Relire les lignes/colonnes sales, derrière la liste actuelle.
+    //    Une règle relue absente de l’ancienne liste est apparue ; les
+    //    anciennes règles retrouvées sont notées dans seen
+    static_assert(MAX_RULES <= 64, "seen : un bit par règle");
+    const int oldCount = set.count;
+    int      incoming  = 0;
+    uint64_t seen      = 0;
+    scan_lines(g, rows, cols, [&](const Rule& r) {
+        if (oldCount + incoming < MAX_RULES) set.rules[oldCount + incoming] = r;
+        incoming++;
+        if (!events) return;
+        bool known = false;
+        for (int k = 0; k < oldCount; k++)
+            if (same_rule(set.rules[k], r)) { seen |= 1ull << k; known = true; }
+        if (!known) events->push(RuleEventKind::Added, r);
+    });
+
+    int kept = 0;
+    for (int i = 0; i < oldCount; i++) kept += !on_dirty_line(set.rules[i]);
+
+    g.dirtyRows = 0;
+    g.dirtyCols = 0;
+
+    if (kept + incoming > MAX_RULES) {
+        rules_parse(g, table);
+        g.mark_all_text_dirty();
+        if (events) {
+            events->clear();
+            events->overflow = true;
         }
+        return true;
+    }
 
-    // -------------------------------------------------------------------------
-    // Scan vertical
-    // -------------------------------------------------------------------------
-    for (int y=0; y<h-2; y++)
-        for (int x=0; x<w; x++) {
-            auto& c0 = g.cell(x,y).objects;
-            auto& c1 = g.cell(x,y+1).objects;
-            auto& c2 = g.cell(x,y+2).objects;
-            if (c0.empty() || c1.empty() || c2.empty()) continue;
-            process(c0[0].type, c1[0].type, c2[0].type);
+    // 2) Retirer les règles des lignes/colonnes sales. Une règle retirée
+    //    n’a disparu que si elle n’est ni relue, ni portée par une règle
+    //    conservée
+    if (events)
+        for (int i = 0; i < oldCount; i++) {
+            const Rule& r = set.rules[i];
+            if (!on_dirty_line(r) || ((seen >> i) & 1u)) continue;
+            bool active = false;
+            for (int k = 0; k < oldCount && !active; k++)
+                active = !on_dirty_line(set.rules[k]) && same_rule(set.rules[k], r);
+            if (!active) events->push(RuleEventKind::Removed, r);
         }
+
+    kept = 0;
+    for (int i = 0; i < oldCount; i++)
+        if (!on_dirty_line(set.rules[i])) set.rules[kept++] = set.rules[i];
+
+    // Règles relues à la suite des règles conservées
+    if (oldCount + incoming <= MAX_RULES) {
+        for (int i = 0; i < incoming; i++) set.rules[kept + i] = set.rules[oldCount + i];
+    } else {
+        int n = kept;
+        scan_lines(g, rows, cols, [&](const Rule& r) { set.rules[n++] = r; });
+    }
+    set.count = kept + incoming;
+
+    if (events) events->prune(set);
+
+    // 3) Reconstruire la table
+    build_table(table, set);
+    return true;
 }
 
 } // namespace baba
@@ -3,9 +3,22 @@
   rules.h — Table des propriétés dynamiques (moteur Baba Is You)
 -------------------------------------------------------------------------------
   Rôle :
-    - Définir la structure Properties avec les attributs (YOU, PUSH, STOP…).
-    - Définir PropertyTable = tableau de Properties par ObjectType.
+    - Définir les propriétés (YOU, PUSH, STOP…) sous forme de bits.
+    - Définir PropertyTable = un masque de propriétés par ObjectType,
+      plus, pour chaque propriété, le masque des types qui la portent.
+    - Négations (IS NOT), possessions (HAS) et règles conditionnelles (ON)
+      sont portées par la même table (denied, holds, cond).
+    - Définir RuleSet = liste persistante des règles actives, mise à jour
+      de façon incrémentale (seules les lignes/colonnes touchées par un mot
+      sont réanalysées).
     - Fournir les fonctions de parsing dans rules.cpp.
+
+  Notes :
+    - Combiné au masque de types par case (Grid::cellTypes), un test du
+      genre "la case contient-elle un objet STOP ?" devient un simple ET :
+          grid.cellTypes[i] & props.types_with(PROP_STOP)
+    - Avec une règle ON, le masque dépend du contenu de la case :
+          grid.cellTypes[i] & props.types_at(PROP_STOP, grid.cellTypes[i])
 ===============================================================================
 */
 
@@ -16,32 +29,246 @@
 namespace baba {
 
 // -----------------------------------------------------------------------------
-//  Ensemble de propriétés pour un type d’objet
+//  Propriétés (un bit chacune, générées depuis vocabulary.h)
 // -----------------------------------------------------------------------------
-struct Properties {
-    bool isYou   = false;
-    bool isPush  = false;
-    bool isStop  = false;
-    bool isWin   = false;
-    bool isSink  = false;
-    bool isKill  = false;
-    bool isHot   = false;
-    bool isMelt  = false;
-    bool isMove  = false;
-    bool isOpen  = false;
-    bool isShut  = false;
-    bool isFloat = false;
+// Rang du bit de chaque propriété (PROP_INDEX_YOU = 0…)
+enum : uint8_t {
+#define BABA_PROP_INDEX(name) PROP_INDEX_##name,
+    BABA_PROPERTIES(BABA_PROP_INDEX)
+#undef BABA_PROP_INDEX
+    PROP_COUNT
+};
+
+enum Property : uint16_t {
+    PROP_NONE = 0,   // mot STATUS sans effet (SWAP)
+#define BABA_PROP_BIT(name) PROP_##name = 1u << PROP_INDEX_##name,
+    BABA_PROPERTIES(BABA_PROP_BIT)
+#undef BABA_PROP_BIT
 };
+static_assert(PROP_COUNT <= 16, "Properties trop petit pour les propriétés");
+
+// Ensemble de propriétés pour un type d’objet (masque de Property)
+using Properties = uint16_t;
+
+// -----------------------------------------------------------------------------
+//  Règle conditionnelle (SUBJECT ON NOUN IS PROPERTY) : la propriété ne vaut
+//  que pour les objets dont la case contient (ou non) les types donnés
+// -----------------------------------------------------------------------------
+struct CondRule {
+    TypeMask   subjects;   // types concernés
+    TypeMask   onAll;      // types tous présents dans la case (ON)
+    TypeMask   onNone;     // types absents de la case (ON NOT)
+    Properties prop;       // une seule propriété
+    uint8_t    negated;    // IS NOT : retire la propriété
+
+    bool holds(TypeMask here) const {
+        return (here & onAll) == onAll && !(here & onNone);
+    }
+};
+
+constexpr int MAX_COND_RULES = 8;
 
 // -----------------------------------------------------------------------------
 //  Table complète : une entrée par ObjectType
 // -----------------------------------------------------------------------------
-using PropertyTable = std::array<Properties, (int)ObjectType::Count>;
+struct PropertyTable {
+    std::array<Properties, (int)ObjectType::Count> flags{};  // propriétés par type
+    std::array<TypeMask, PROP_COUNT>               types{};  // types portant chaque propriété
+    std::array<TypeMask, PROP_COUNT>               denied{}; // types visés par X IS NOT prop
+
+    // Transformations (NOUN IS NOUN) : becomes[t] = types que t devient.
+    // Bit Empty = t disparaît ; bit t lui-même (BABA IS BABA) = t protégé.
+    std::array<TypeMask, (int)ObjectType::Count>   becomes{};
+    TypeMask transforms = 0;   // types ayant au moins une cible
+
+    // Possessions (NOUN HAS NOUN) : holds[t] = types laissés par t détruit
+    std::array<TypeMask, (int)ObjectType::Count>   holds{};
+
+    // Règles conditionnelles (ON), évaluées case par case (types_at)
+    std::array<CondRule, MAX_COND_RULES>           cond{};
+    uint8_t condCount = 0;
+    bool    condOverflow = false;   // au moins une règle ignorée (table pleine)
+
+    Properties operator[](int t)        const { return flags[t]; }
+    Properties operator[](ObjectType t) const { return flags[(int)t]; }
+
+    bool has(ObjectType t, Property p) const { return (flags[(int)t] & p) != 0; }
+
+    // Masque des types portant la propriété p (un seul bit), hors conditions
+    TypeMask types_with(Property p) const { return types[__builtin_ctz(p)]; }
+
+    // Types pouvant porter p dans au moins une case (conditions comprises)
+    TypeMask types_any(Property p) const {
+        TypeMask m = types[__builtin_ctz(p)];
+        for (int k = 0; k < condCount; ++k)
+            if ((cond[k].prop & p) && !cond[k].negated) m |= cond[k].subjects;
+        return m & ~denied[__builtin_ctz(p)];
+    }
+
+    // Types portant p dans une case de contenu here (conditions comprises)
+    TypeMask types_at(Property p, TypeMask here) const {
+        const int b = __builtin_ctz(p);
+        TypeMask m = types[b], deny = denied[b];
+        for (int k = 0; k < condCount; ++k) {
+            const CondRule& c = cond[k];
+            if (!(c.prop & p) || !c.holds(here)) continue;
+            if (c.negated) deny |= c.subjects;
+            else           m    |= c.subjects;
+        }
+        return m & ~deny;
+    }
+
+    void set(ObjectType t, Property p) {
+        flags[(int)t] |= p;
+        types[__builtin_ctz(p)] |= type_bit(t);
+    }
+
+    // Règle conditionnelle : une entrée de même condition et même propriété
+    // reçoit ses sujets (BABA ON FLAG IS WIN + ROCK ON FLAG IS WIN = une
+    // entrée). false si la table est pleine : la règle est ignorée.
+    bool add_cond(const CondRule& c) {
+        for (int k = 0; k < condCount; ++k) {
+            CondRule& e = cond[k];
+            if (e.onAll == c.onAll && e.onNone == c.onNone &&
+                e.prop == c.prop && e.negated == c.negated) {
+                e.subjects |= c.subjects;
+                return true;
+            }
+        }
+        if (condCount == MAX_COND_RULES) {
+            condOverflow = true;
+            return false;
+        }
+        cond[condCount++] = c;
+        return true;
+    }
+
+    // X IS NOT p : l’emporte sur toute règle positive, quel que soit l’ordre
+    void deny(ObjectType t, Property p) {
+        denied[__builtin_ctz(p)] |= type_bit(t);
+    }
+
+    void set_becomes(ObjectType t, ObjectType target) {
+        becomes[(int)t] |= type_bit(target);
+        transforms      |= type_bit(t);
+    }
+
+    // X IS NOT Y : à appliquer après toutes les transformations positives
+    void unset_becomes(ObjectType t, ObjectType target) {
+        becomes[(int)t] &= ~type_bit(target);
+        if (!becomes[(int)t]) transforms &= ~type_bit(t);
+    }
+
+    // Applique les négations accumulées (deny) aux masques positifs
+    void finish() {
+        for (int b = 0; b < PROP_COUNT; ++b) {
+            if (!denied[b]) continue;
+            types[b] &= ~denied[b];
+            for (TypeMask m = denied[b]; m; m &= m - 1)
+                flags[(int)lowest_type(m)] &= (Properties)~(1u << b);
+        }
+    }
+
+    void clear() {
+        flags.fill(0);
+        types.fill(0);
+        denied.fill(0);
+        becomes.fill(0);
+        transforms = 0;
+        holds.fill(0);
+        condCount = 0;
+        condOverflow = false;
+    }
+};
+
+// -----------------------------------------------------------------------------
+//  Règle active, telle que produite par l’analyseur : une règle par
+//  complément, sujets déjà combinés (AND) et résolus (NOT BABA = tous les
+//  objets sauf BABA). Repérée par la ligne qui la porte.
+// -----------------------------------------------------------------------------
+enum RuleFlags : uint8_t {
+    RULE_HAS = 1u << 0,    // verbe HAS (sinon IS)
+    RULE_NOT = 1u << 1,    // complément nié (IS NOT / HAS NOT)
+};
+
+struct Rule {
+    TypeMask   subjects;   // types concernés (ex : bit Baba)
+    TypeMask   onAll;      // condition ON : types tous présents dans la case
+    TypeMask   onNone;     // condition ON NOT : types absents de la case
+    ObjectType word;       // complément : mot STATUS (Text_You) ou nom (Text_Rock)
+    uint8_t    flags;      // RuleFlags
+    uint8_t    vertical;   // 0 = phrase horizontale, 1 = verticale
+    uint8_t    line;       // ligne (horizontale) ou colonne (verticale)
+};
+
+constexpr int MAX_RULES = 64;
+
+// Liste persistante des règles actives (conservée d’un coup à l’autre)
+struct RuleSet {
+    std::array<Rule, MAX_RULES> rules;
+    int count = 0;
+};
+
+// Même règle au sens du jeu (sujets, condition, verbe, complément) ;
+// la ligne qui la porte n’est pas comparée
+inline bool same_rule(const Rule& a, const Rule& b) {
+    return a.subjects == b.subjects && a.onAll == b.onAll && a.onNone == b.onNone &&
+           a.word == b.word && a.flags == b.flags;
+}
+
+// -----------------------------------------------------------------------------
+//  Événements de règles : règles apparues / disparues pendant un coup
+//  - Différence sur l’ensemble des règles actives : une phrase déplacée en
+//    bloc, ou doublée par une copie restée en place, ne produit rien.
+//  - Une règle apparue puis disparue dans le même coup s’annule.
+//  - Permet au rendu, au son ou au HUD de réagir au changement sans
+//    comparer la PropertyTable à chaque frame.
+// -----------------------------------------------------------------------------
+enum class RuleEventKind : uint8_t {
+    Added,
+    Removed,
+};
+
+struct RuleEvent {
+    Rule          rule;   // règle concernée (ligne / colonne comprise)
+    RuleEventKind kind;
+};
+
+constexpr int MAX_RULE_EVENTS = 16;
+
+struct RuleEvents {
+    std::array<RuleEvent, MAX_RULE_EVENTS> events;
+    uint8_t count    = 0;
+    // Liste incomplète : toutes les règles ont pu changer, ignorer ce coup.
+    // Levé aussi quand la liste de règles déborde (MAX_RULES) ; les coups
+    // suivants se comparent aux règles d’avant ce coup
+    bool    overflow = false;
+
+    void clear() { count = 0; overflow = false; }
+
+    // Ajoute un événement, ou annule l’événement inverse déjà noté
+    void push(RuleEventKind kind, const Rule& r);
+
+    // Retire les événements démentis par la liste active (règle encore
+    // présente ailleurs, ou de nouveau absente)
+    void prune(const RuleSet& set);
+};
 
 // -----------------------------------------------------------------------------
 //  Fonctions exposées par rules.cpp
 // -----------------------------------------------------------------------------
 void rules_reset(PropertyTable& table);
+
+// Analyse complète de la grille (référence)
 void rules_parse(const Grid& g, PropertyTable& table);
 
+// Analyse incrémentale : réévalue uniquement les phrases des lignes/colonnes
+// marquées dans g.dirtyRows / g.dirtyCols, met à jour set et reconstruit
+// table. Résultat identique à rules_parse(). Retourne false si rien à faire.
+// Si events est fourni, les règles apparues / disparues y sont ajoutées
+// (l’appelant le vide au début du coup) ; au-delà de MAX_RULES règles, ils
+// sont effacés et events->overflow est levé.
+bool rules_update(Grid& g, RuleSet& set, PropertyTable& table,
+                  RuleEvents* events = nullptr);
+
 } // namespace baba
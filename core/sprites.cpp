@@ -3,14 +3,15 @@
   sprites.cpp — Implémentation de l’atlas de sprites
 -------------------------------------------------------------------------------
   Rôle :
-    - Mapper chaque ObjectType vers un index dans l’atlas.
+    - Mapper chaque ObjectType vers un index dans l’atlas (colonne tuile
+      du registre vocabulary.h).
     - Convertir cet index en coordonnées source (x,y,w,h).
     - Dessiner une cellule via gfx_drawAtlas().
 
   Notes :
     - L’atlas utilisé fait 256×32 px (16 colonnes × 2 lignes).
     - Chaque sprite fait 16×16 px.
-    - Les indices ci-dessous correspondent à l’atlas minimal blanc.
+    - Les indices du registre correspondent à l’atlas minimal blanc.
 
   Auteur : Jean-Charles LEBEAU
   Date   : Janvier 2026
@@ -42,51 +43,14 @@ const uint16_t* getAtlasPixels()
 
 // -----------------------------------------------------------------------------
 //  Table de correspondance ObjectType → index dans l’atlas
+//  (générée depuis vocabulary.h ; ligne 0 : objets, ligne 1 : mots,
+//  index 7 = case vide pour les types sans tuile)
 // -----------------------------------------------------------------------------
-static uint16_t g_spriteIndex[(size_t)ObjectType::Count];
-
-// -----------------------------------------------------------------------------
-//  Initialisation des indices de sprites
-// -----------------------------------------------------------------------------
-void sprites_init()
-{
-    // Valeur par défaut : EMPTY (index 7)
-    for (size_t i = 0; i < (size_t)ObjectType::Count; i++)
-        g_spriteIndex[i] = 7;
-
-    // -------------------------------------------------------------------------
-    // Ligne 0 : objets
-    // -------------------------------------------------------------------------
-    g_spriteIndex[(size_t)ObjectType::Baba] = 0;
-    g_spriteIndex[(size_t)ObjectType::Wall] = 1;
-    g_spriteIndex[(size_t)ObjectType::Rock] = 2;
-    g_spriteIndex[(size_t)ObjectType::Flag] = 3;
-    g_spriteIndex[(size_t)ObjectType::Lava] = 4;
-    g_spriteIndex[(size_t)ObjectType::Goop] = 5;
-    g_spriteIndex[(size_t)ObjectType::Love] = 6;
-    g_spriteIndex[(size_t)ObjectType::Empty] = 7;
-
-    // -------------------------------------------------------------------------
-    // Ligne 1 : mots
-    // -------------------------------------------------------------------------
-    g_spriteIndex[(size_t)ObjectType::Text_Baba]  = 16;
-    g_spriteIndex[(size_t)ObjectType::Text_Wall]  = 17;
-    g_spriteIndex[(size_t)ObjectType::Text_Rock]  = 18;
-    g_spriteIndex[(size_t)ObjectType::Text_Flag]  = 19;
-    g_spriteIndex[(size_t)ObjectType::Text_Lava]  = 20;
-    g_spriteIndex[(size_t)ObjectType::Text_Goop]  = 21;
-    g_spriteIndex[(size_t)ObjectType::Text_Love]  = 22;
-    g_spriteIndex[(size_t)ObjectType::Text_Empty] = 23;
-
-    g_spriteIndex[(size_t)ObjectType::Text_Is]    = 24;
-    g_spriteIndex[(size_t)ObjectType::Text_Push]  = 25;
-    g_spriteIndex[(size_t)ObjectType::Text_Stop]  = 26;
-    g_spriteIndex[(size_t)ObjectType::Text_Win]   = 27;
-    g_spriteIndex[(size_t)ObjectType::Text_You]   = 28;
-    g_spriteIndex[(size_t)ObjectType::Text_Sink]  = 29;
-    g_spriteIndex[(size_t)ObjectType::Text_Kill]  = 30;
-    g_spriteIndex[(size_t)ObjectType::Text_Swap]  = 31;
-}
+static constexpr uint16_t g_spriteIndex[(size_t)ObjectType::Count] = {
+#define BABA_SPRITE_INDEX(type, kind, object, prop, tile) tile,
+    BABA_OBJECT_TYPES(BABA_SPRITE_INDEX)
+#undef BABA_SPRITE_INDEX
+};
 
 // -----------------------------------------------------------------------------
 //  Calcule le rectangle source dans l’atlas pour un ObjectType donné
@@ -122,5 +86,15 @@ void draw_sprite(int x, int y, ObjectType t)
     );
 }
 
+// -----------------------------------------------------------------------------
+//  draw_cell() — Dessine une cellule (tous les objets de la pile)
+// -----------------------------------------------------------------------------
+void draw_cell(int x, int y, const Cell& c)
+{
+    for (auto& obj : c.objects) {
+        draw_sprite(x, y, obj.type);
+    }
+}
+
 
 } // namespace baba
@@ -4,11 +4,12 @@
   sprites.h — Gestion de l’atlas de sprites 16×16
 -------------------------------------------------------------------------------
   Rôle :
-    - Associer chaque ObjectType à une tuile dans l’atlas.
+    - Associer chaque ObjectType à une tuile dans l’atlas (table constante
+      générée depuis vocabulary.h : aucune initialisation).
     - Fournir sprite_rect_for() pour obtenir la zone source dans l’image.
     - Fournir draw_sprite() pour dessiner un objet unique.
-    - La fonction draw_cell() (dans grid.cpp) utilise draw_sprite() pour
-      dessiner tous les objets d’une cellule.
+    - Fournir draw_cell() pour dessiner tous les objets d’une cellule
+      (la grille elle-même ne dépend pas du rendu).
 
   Notes :
     - L’atlas est une image unique (ex : tileset_16x16.png).
@@ -30,13 +31,13 @@ struct SpriteRect {
     int x, y, w, h;
 };
 
-// Initialise la table de correspondance ObjectType → sprite
-void sprites_init();
-
 // Retourne le rectangle source pour un ObjectType
 SpriteRect sprite_rect_for(ObjectType type);
 
 // Dessine un sprite unique 
 void draw_sprite(int x, int y, ObjectType t);
 
+// Dessine tous les objets d’une cellule (pile)
+void draw_cell(int x, int y, const Cell& c);
+
 } // namespace baba
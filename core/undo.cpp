@@ -0,0 +1,158 @@
+/*
+===============================================================================
+  undo.cpp — Implémentation du journal d’annulation
+-------------------------------------------------------------------------------
+  Rôle :
+    - Écrire les entrées dans le tampon circulaire, en oubliant les coups
+      les plus anciens quand il est plein.
+    - Rejouer un coup à l’envers (undo) ou à l’endroit (redo) à l’aide des
+      primitives de pile de la grille.
+
+  Notes :
+    - Un retrait de plusieurs objets est journalisé comme une suite de
+      retraits unitaires, du plus haut au plus bas : rejouée à l’envers,
+      chaque réinsertion retrouve sa position exacte (ordre des piles
+      conservé, donc état strictement identique).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#include "undo.h"
+
+namespace baba {
+
+void UndoJournal::attach(UndoEntry* storage, int capacity)
+{
+    buf_ = storage;
+    cap_ = capacity;
+    clear();
+}
+
+void UndoJournal::clear()
+{
+    tail_ = len_ = redoLen_ = 0;
+    sep_  = -1;
+    open_ = pending_ = lost_ = false;
+    depth_ = 0;
+}
+
+// -----------------------------------------------------------------------------
+//  Ouvre un coup : le séparateur n’est écrit qu’à la première modification
+// -----------------------------------------------------------------------------
+void UndoJournal::begin_move()
+{
+    if (depth_++) return;   // bloc imbriqué : même coup
+    open_    = (cap_ > 0);
+    pending_ = true;
+    lost_    = false;
+}
+
+// -----------------------------------------------------------------------------
+//  Oublie le coup le plus ancien. false si seul le coup en cours reste.
+// -----------------------------------------------------------------------------
+bool UndoJournal::drop_oldest_move()
+{
+    int n = 1;   // at(0) est toujours un séparateur
+    while (n < len_ && at(n).op != UNDO_MOVE) ++n;
+    if (n >= len_) return false;
+
+    tail_ = (tail_ + n) % cap_;
+    len_ -= n;
+    return true;
+}
+
+void UndoJournal::record(uint8_t op, int cell, int pos, Object o)
+{
+    if (!open_ || lost_) return;
+
+    if (pending_) {
+        // Nouveau coup effectif : l’historique redo n’a plus de sens
+        pending_ = false;
+        redoLen_ = 0;
+        record(UNDO_MOVE, 0, 0, Object{ObjectType::Empty});
+        if (lost_) return;
+    }
+
+    if (len_ == cap_ && !drop_oldest_move()) {
+        if (op == UNDO_MOVE) {
+            // Le tampon ne contient qu’un ancien coup : on l’oublie
+            len_ = 0;
+        } else {
+            // Le coup en cours remplit à lui seul le tampon : il ne pourra
+            // pas être annulé, ni aucun coup antérieur. Seul l’historique
+            // est oublié : le coup reste ouvert (depth_ inchangé).
+            tail_ = len_ = redoLen_ = 0;
+            lost_ = true;
+            return;
+        }
+    }
+
+    if (op == UNDO_MOVE) sep_ = (tail_ + len_) % cap_;
+    at(len_++) = UndoEntry{ (uint16_t)cell, op, (uint8_t)pos, o };
+}
+
+// -----------------------------------------------------------------------------
+//  Résultat du coup en cours : dans son séparateur, s’il a été écrit (coup
+//  effectif) et si le coup tient encore dans le tampon
+// -----------------------------------------------------------------------------
+void UndoJournal::set_result(uint8_t flags)
+{
+    if (!open_ || pending_ || lost_ || sep_ < 0) return;
+    buf_[sep_].pos = flags;
+}
+
+// -----------------------------------------------------------------------------
+//  Annulation : entrées du dernier coup, de la plus récente à la plus ancienne
+// -----------------------------------------------------------------------------
+bool UndoJournal::undo(Grid& g)
+{
+    if (len_ == 0) return false;
+
+    int n = len_;
+    while (--n >= 0) {
+        const UndoEntry& e = at(n);
+        if (e.op == UNDO_MOVE) break;
+
+        if (e.op == UNDO_PUSH) {
+            int top = g.slots[e.cell].count - 1;
+            g.stack_erase(e.cell, top, top + 1);
+        } else if (e.op == UNDO_INSERT) {
+            g.stack_erase(e.cell, e.pos, e.pos + 1);
+        } else if (!g.stack_insert(e.cell, e.pos, e.obj)) {
+            g.stack_overflow(e.cell, e.obj);
+        }
+    }
+
+    redoLen_ += len_ - n;
+    len_ = n;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+//  Rejeu : entrées du coup suivant, dans l’ordre d’origine
+// -----------------------------------------------------------------------------
+bool UndoJournal::redo(Grid& g, uint8_t* result)
+{
+    if (redoLen_ == 0) return false;
+    if (result) *result = at(len_).pos;
+
+    int n = 1;   // at(len_) est le séparateur du coup
+    for (; n < redoLen_; ++n) {
+        const UndoEntry& e = at(len_ + n);
+        if (e.op == UNDO_MOVE) break;
+
+        bool ok = true;
+        if (e.op == UNDO_PUSH)        ok = g.stack_push(e.cell, e.obj);
+        else if (e.op == UNDO_INSERT) ok = g.stack_insert(e.cell, e.pos, e.obj);
+        else                          g.stack_erase(e.cell, e.pos, e.pos + 1);
+        if (!ok) g.stack_overflow(e.cell, e.obj);
+    }
+
+    len_     += n;
+    redoLen_ -= n;
+    return true;
+}
+
+} // namespace baba
@@ -0,0 +1,118 @@
+/*
+===============================================================================
+  undo.h — Journal d’annulation (undo / redo) par deltas
+-------------------------------------------------------------------------------
+  Rôle :
+    - Enregistrer, pendant un coup, les modifications élémentaires de la
+      grille : objet empilé dans une case, objet retiré d’une case.
+      Un déplacement = retrait + ajout ; une destruction = retrait ;
+      une transformation = retrait + ajout d’un autre type.
+    - Annuler / rejouer un coup en rejouant son journal à l’envers / à
+      l’endroit, sans jamais copier la grille (768 cases).
+
+  Notes :
+    - Le journal est un tampon circulaire de taille fixe fourni par
+      l’appelant (budget mémoire configurable, aucune allocation).
+      Quand il est plein, les coups les plus anciens sont oubliés.
+    - Les règles ne sont pas journalisées : elles se déduisent de la
+      grille. Les cases touchées par l’annulation marquent leurs
+      lignes/colonnes, rules_update() fait le reste.
+    - La grille écrit dans le journal via Grid::journal, uniquement entre
+      begin_move() et end_move() (appelés par step()). Un chargement de
+      niveau (Grid::reset) vide l’historique.
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#pragma once
+#include "grid.h"
+
+namespace baba {
+
+// -----------------------------------------------------------------------------
+//  Entrée du journal
+// -----------------------------------------------------------------------------
+enum UndoOp : uint8_t {
+    UNDO_MOVE   = 0,  // début d’un coup (séparateur)
+    UNDO_PUSH   = 1,  // obj empilé au sommet de la case cell
+    UNDO_ERASE  = 2,  // obj retiré de la case cell, à la position pos
+    UNDO_INSERT = 3,  // obj inséré dans la case cell, à la position pos
+};
+
+struct UndoEntry {
+    uint16_t cell;
+    uint8_t  op;
+    uint8_t  pos;    // séparateur (UNDO_MOVE) : résultat du coup (UndoResult)
+    Object   obj;
+};
+
+// Résultat d’un coup, noté dans son séparateur : un rejeu (redo) rend la
+// victoire / la mort du coup d’origine, y compris un YOU détruit par une
+// interaction, que la grille rejouée ne montre plus
+enum UndoResult : uint8_t {
+    UNDO_WON  = 1,
+    UNDO_DIED = 2,
+};
+
+// -----------------------------------------------------------------------------
+//  Journal circulaire
+// -----------------------------------------------------------------------------
+class UndoJournal {
+public:
+    UndoJournal() = default;
+    UndoJournal(UndoEntry* storage, int capacity) { attach(storage, capacity); }
+
+    // Associe le tampon (capacity entrées) et vide l’historique
+    void attach(UndoEntry* storage, int capacity);
+    void clear();
+
+    // Délimitation d’un coup. Un coup sans modification n’est pas enregistré.
+    // Les appels s’imbriquent : seul le bloc le plus externe délimite le coup
+    // (input_apply englobe step() et les transformations qui suivent).
+    void begin_move();
+    void end_move() { if (depth_ && --depth_ == 0) open_ = false; }
+
+    // Note le résultat (UndoResult) du coup en cours, s’il est enregistré.
+    // Appelé par step() avant end_move().
+    void set_result(uint8_t flags);
+
+    // Appelés par la grille (Grid::stack_push / stack_erase…)
+    void record_push(int cell, Object o)           { record(UNDO_PUSH, cell, 0, o); }
+    void record_erase(int cell, int pos, Object o) { record(UNDO_ERASE, cell, pos, o); }
+    void record_insert(int cell, int pos, Object o){ record(UNDO_INSERT, cell, pos, o); }
+
+    // Annule / rejoue un coup entier. Retourne false s’il n’y en a pas.
+    // L’appelant relance ensuite rules_update(). result (facultatif) reçoit
+    // le résultat du coup rejoué (UndoResult).
+    bool undo(Grid& g);
+    bool redo(Grid& g, uint8_t* result = nullptr);
+
+    bool can_undo() const { return len_ > 0; }
+    bool can_redo() const { return redoLen_ > 0; }
+
+    int used()     const { return len_; }   // entrées occupées (hors redo)
+    int capacity() const { return cap_; }
+
+private:
+    void record(uint8_t op, int cell, int pos, Object o);
+    bool drop_oldest_move();
+
+    UndoEntry&       at(int n)       { return buf_[(tail_ + n) % cap_]; }
+    const UndoEntry& at(int n) const { return buf_[(tail_ + n) % cap_]; }
+
+    UndoEntry* buf_ = nullptr;
+    int cap_     = 0;
+    int tail_    = 0;   // index de l’entrée la plus ancienne
+    int len_     = 0;   // entrées annulables (de tail_ à la tête)
+    int redoLen_ = 0;   // entrées rejouables après la tête
+    int sep_     = -1;  // séparateur du coup en cours (index dans buf_)
+
+    bool open_    = false;   // un coup est en cours
+    bool pending_ = false;   // séparateur du coup pas encore écrit
+    bool lost_    = false;   // le coup en cours ne tient pas dans le tampon
+    uint8_t depth_ = 0;      // imbrication de begin_move()
+};
+
+} // namespace baba
@@ -0,0 +1,119 @@
+/*
+===============================================================================
+  vocabulary.h — Registre des objets et des mots (source unique)
+-------------------------------------------------------------------------------
+  Rôle :
+    - Décrire en un seul endroit chaque ObjectType : sa classe de mot,
+      l’objet désigné par un nom, la propriété portée par un mot STATUS
+      et sa tuile dans l’atlas.
+    - Décrire en un seul endroit les propriétés (YOU, PUSH…).
+    - Les tables du moteur en sont générées à la compilation (X-macros) :
+        * enum ObjectType, OBJECT_KIND[]      (grid.h)
+        * enum Property, PROP_COUNT           (rules.h)
+        * classes de mots, nom → objet,
+          mot STATUS → propriété              (rules.cpp)
+        * ObjectType → index d’atlas          (sprites.cpp)
+
+  Ajouter un mot :
+    - Une ligne dans BABA_OBJECT_TYPES (et, pour une nouvelle propriété,
+      une ligne dans BABA_PROPERTIES) ; aucun switch à compléter.
+    - L’ordre des lignes fixe les valeurs de l’enum : les niveaux (codes
+      uint8_t) et les empreintes enregistrées (replays) en dépendent.
+      Ajouter de préférence en fin de groupe, avant Count.
+    - Les noms TEXT_BABA..TEXT_LOVE suivent l’ordre des objets (vérifié par
+      rules.cpp).
+
+  Colonnes de BABA_OBJECT_TYPES :
+    X(type, classe, objet désigné, propriété, tuile)
+    - classe    : WordKind (Object = pas un mot).
+    - objet     : pour un nom, l’ObjectType désigné ; Empty sinon.
+    - propriété : pour un mot STATUS, la propriété (NONE : pas encore
+                  gérée, ex : SWAP).
+    - tuile     : index dans l’atlas 16×2 ; 7 = case vide (pas de tuile).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#pragma once
+#include <cstdint>
+
+namespace baba {
+
+// -----------------------------------------------------------------------------
+//  Classe d’un type : objet physique ou classe de mot
+//  (l’ordre des mots est celui des entrées de l’automate de rules.cpp)
+// -----------------------------------------------------------------------------
+enum class WordKind : uint8_t {
+    Noun,     // BABA, ROCK… (sujet, condition ou complément)
+    Prop,     // YOU, PUSH… (complément de IS)
+    Is,
+    Has,
+    And,
+    Not,
+    On,
+    Object,   // objet physique (ou Empty) : pas un mot
+};
+
+// -----------------------------------------------------------------------------
+//  Propriétés (un bit chacune, dans cet ordre)
+// -----------------------------------------------------------------------------
+#define BABA_PROPERTIES(P) \
+    P(YOU)   \
+    P(PUSH)  \
+    P(STOP)  \
+    P(WIN)   \
+    P(SINK)  \
+    P(KILL)  \
+    P(HOT)   \
+    P(MELT)  \
+    P(MOVE)  \
+    P(OPEN)  \
+    P(SHUT)  \
+    P(FLOAT)
+
+// -----------------------------------------------------------------------------
+//  Types d’objets du jeu (objets physiques + mots textuels)
+// -----------------------------------------------------------------------------
+#define BABA_OBJECT_TYPES(X) \
+    X(Empty,      Object, Empty, NONE,   7) \
+    /* Objets physiques */                  \
+    X(Baba,       Object, Empty, NONE,   0) \
+    X(Wall,       Object, Empty, NONE,   1) \
+    X(Rock,       Object, Empty, NONE,   2) \
+    X(Flag,       Object, Empty, NONE,   3) \
+    X(Lava,       Object, Empty, NONE,   4) \
+    X(Goop,       Object, Empty, NONE,   5) \
+    X(Love,       Object, Empty, NONE,   6) \
+    /* Mots (noms) */                       \
+    X(Text_Baba,  Noun,   Baba,  NONE,  16) \
+    X(Text_Wall,  Noun,   Wall,  NONE,  17) \
+    X(Text_Rock,  Noun,   Rock,  NONE,  18) \
+    X(Text_Flag,  Noun,   Flag,  NONE,  19) \
+    X(Text_Lava,  Noun,   Lava,  NONE,  20) \
+    X(Text_Goop,  Noun,   Goop,  NONE,  21) \
+    X(Text_Love,  Noun,   Love,  NONE,  22) \
+    X(Text_Empty, Noun,   Empty, NONE,  23) \
+    /* Mots (verbes / propriétés) */        \
+    X(Text_Is,    Is,     Empty, NONE,  24) \
+    X(Text_Push,  Prop,   Empty, PUSH,  25) \
+    X(Text_Stop,  Prop,   Empty, STOP,  26) \
+    X(Text_Win,   Prop,   Empty, WIN,   27) \
+    X(Text_You,   Prop,   Empty, YOU,   28) \
+    X(Text_Sink,  Prop,   Empty, SINK,  29) \
+    X(Text_Kill,  Prop,   Empty, KILL,  30) \
+    X(Text_Swap,  Prop,   Empty, NONE,  31) \
+    X(Text_Hot,   Prop,   Empty, HOT,    7) \
+    X(Text_Melt,  Prop,   Empty, MELT,   7) \
+    X(Text_Move,  Prop,   Empty, MOVE,   7) \
+    X(Text_Open,  Prop,   Empty, OPEN,   7) \
+    X(Text_Shut,  Prop,   Empty, SHUT,   7) \
+    X(Text_Float, Prop,   Empty, FLOAT,  7) \
+    /* Mots (liaisons et conditions) */     \
+    X(Text_And,   And,    Empty, NONE,   7) \
+    X(Text_Not,   Not,    Empty, NONE,   7) \
+    X(Text_Has,   Has,    Empty, NONE,   7) \
+    X(Text_On,    On,     Empty, NONE,   7)
+
+} // namespace baba
@@ -28,5 +28,28 @@ constexpr int GRID_Y0 = 0;
 constexpr int CENTER_EPS = 2;   // tolérance pour être centré
 constexpr int SNAP_EPS   = 3;   // distance sous laquelle on "snap" au centre
 
+// Budget mémoire du journal d’annulation (undo/redo), en octets.
+// ~6 octets par modification élémentaire, soit plusieurs centaines de coups.
+constexpr int UNDO_BUDGET_BYTES = 16 * 1024;
+
+// Mode développement : enregistrement des entrées de chaque niveau (rejeu /
+// non-régression). Le journal est écrit sur la carte SD à la fin du niveau
+// (victoire ou mort) : REPLAY_DIR/levelNN.rec, relu par l’outil hôte
+// host/replay.cpp.
+constexpr bool        INPUT_RECORDING = false;
+constexpr const char* REPLAY_DIR      = "/sdcard/babaisu/replays";
+
+// Pack de niveaux sur la carte SD (format levelpack.h). Absent ou invalide :
+// le pack intégré en flash (levels_data.cpp) est utilisé.
+constexpr const char* LEVEL_PACK_PATH = "/sdcard/babaisu/levels.pak";
+
+// Mode développement : rechargement à chaud du pack de la carte SD.
+// Entre deux coups, toutes les LEVEL_WATCH_FRAMES frames, la date de
+// modification et la taille de LEVEL_PACK_PATH sont relevées (stat) ; si
+// elles changent, le pack est rouvert et le niveau courant rechargé en place
+// s’il a changé (host/levelwatch.cpp fait de même sur PC).
+constexpr bool LEVEL_HOT_RELOAD   = false;
+constexpr int  LEVEL_WATCH_FRAMES = 40;   // 1 s à 40 FPS
+
 // Mode debug (0 = off, 1 = on)
 extern int debug;
@@ -10,7 +10,9 @@
       dans le projet AKA.
 
   Notes :
-    - Les tableaux levelX[] sont déclarés comme const uint8_t.
+    - Les niveaux ne sont plus des tableaux C : ces noms sont les codes des
+      cartes ASCII de assets/levels/, compilées en pack par host/levelc.cpp
+      (qui accepte aussi les mots sans macro ici, ex : W_HOT).
     - Chaque macro convertit un ObjectType en uint8_t via static_cast.
     - Exemple : WALL → ObjectType::Wall → uint8_t.
 ===============================================================================
@@ -51,3 +53,8 @@
 #define W_KILL  static_cast<uint8_t>(ObjectType::Text_Kill)
 #define W_SINK  static_cast<uint8_t>(ObjectType::Text_Sink)
 #define W_SWAP  static_cast<uint8_t>(ObjectType::Text_Swap)
+
+#define W_AND   static_cast<uint8_t>(ObjectType::Text_And )
+#define W_NOT   static_cast<uint8_t>(ObjectType::Text_Not )
+#define W_HAS   static_cast<uint8_t>(ObjectType::Text_Has )
+#define W_ON    static_cast<uint8_t>(ObjectType::Text_On  )
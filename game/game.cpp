@@ -5,7 +5,7 @@
   Rôle :
     - Initialiser l’état global du jeu.
     - Charger les niveaux.
-    - Appliquer les règles (rules_parse).
+    - Appliquer les règles (rules_update, incrémental).
     - Appliquer les déplacements (step).
     - Gérer les états (victoire, mort).
     - Dessiner la grille avec caméra (centrage sur YOU + joystick libre).
@@ -21,11 +21,15 @@
 #include "game/levels.h"
 #include "core/input.h"
 #include "core/graphics.h"
+#include "core/replay.h"
+#include "game/config.h"
 
 #include "assets/gfx/title.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include <algorithm> // min/max
+#include <cstdio>
+#include <sys/stat.h>
 
 namespace baba {
 
@@ -35,6 +39,20 @@ namespace baba {
 static GameState g_state;
 static GameMode  g_mode = GameMode::Title;
 
+// Tampon du journal d’annulation (budget fixe, voir config.h)
+static UndoEntry g_undoBuffer[UNDO_BUDGET_BYTES / sizeof(UndoEntry)];
+
+// Entrées du niveau en cours (voir INPUT_RECORDING)
+static InputLog g_inputLog;
+
+// États initiaux du niveau courant et du niveau préchargé :
+// recommencer (mort) ou passer au niveau suivant = une copie
+static LevelCache g_levels;
+
+// Rechargement à chaud du pack SD (LEVEL_HOT_RELOAD)
+static LevelFileStamp g_packStamp;
+static int            g_watchFrames = 0;
+
 GameState& game_state() { return g_state; }
 GameMode&  game_mode()  { return g_mode; }
 
@@ -57,18 +75,16 @@ constexpr int VIEW_TILES_H  = SCREEN_H / TILE_SIZE; // 15
 
 struct Point { int x; int y; };
 
-// Trouve la position du premier objet YOU
+// Trouve la position du premier objet YOU (index par type de la grille)
 static Point find_you(const Grid& g, const PropertyTable& props) {
-    for (int y = 0; y < g.height; ++y) {
-        for (int x = 0; x < g.width; ++x) {
-            for (const auto& obj : g.cell(x, y).objects) {
-                const Properties& pr = props[(int)obj.type];
-                if (pr.isYou) {
-                    return {x, y};
-                }
-            }
-        }
-    }
+    // Candidats par l’index, puis condition ON vérifiée case par case
+    // (comme movement.cpp) : un sujet de X ON Y IS YOU n’est YOU que là
+    // où Y est présent
+    int i = -1;
+    g.cells_with(props.types_any(PROP_YOU)).for_each([&](int k) {
+        if (i < 0 && (g.cellTypes[k] & props.types_at(PROP_YOU, g.cellTypes[k]))) i = k;
+    });
+    if (i >= 0) return {i % g.width, i / g.width};
     return {g.width / 2, g.height / 2}; // fallback
 }
 
@@ -132,8 +148,18 @@ void fade_in(int delayMs, int steps)
 //  INITIALISATION DU JEU
 // ============================================================================
 void game_init() {
-    g_state = GameState{};
-    sprites_init();
+    // Réinitialisation champ par champ : un GameState{} temporaire
+    // (grille en arène de plusieurs Ko) déborderait la pile de app_main
+    g_state.currentLevel = 0;
+    g_state.hasWon  = false;
+    g_state.hasDied = false;
+    g_state.undo.attach(g_undoBuffer, sizeof(g_undoBuffer) / sizeof(g_undoBuffer[0]));
+    g_state.grid.journal = &g_state.undo;
+
+    // Pack de la carte SD s’il existe, sinon pack intégré
+    if (LEVEL_HOT_RELOAD) levels_file_changed(LEVEL_PACK_PATH, g_packStamp);
+    if (levels_open(LEVEL_PACK_PATH))
+        printf("[Levels] %d niveaux depuis %s\n", levels_count(), LEVEL_PACK_PATH);
     game_load_level(0);
 }
 
@@ -145,12 +171,72 @@ void game_load_level(int index) {
     g_state.hasWon = false;
     g_state.hasDied = false;
 
-    load_level(index, g_state.grid);
-    rules_parse(g_state.grid, g_state.props);
+    // Décodage + analyse des règles au premier chargement (sauf niveau
+    // préchargé), copie de l’état initial ensuite. Les règles de départ ne
+    // sont pas des événements.
+    g_levels.load(index, g_state.grid, g_state.rules, g_state.props);
+    g_state.ruleEvents.clear();
+
+    if (INPUT_RECORDING)
+        input_log_begin(g_inputLog, index, g_state.grid, g_state.undo.capacity());
 
     g_camera = Camera{};
 }
 
+// ============================================================================
+//  ENREGISTREMENT DES ENTRÉES
+// ============================================================================
+// Écrit le journal du niveau terminé sur la carte SD (REPLAY_DIR/levelNN.rec)
+static void save_input_log()
+{
+    char path[64];
+    mkdir("/sdcard/babaisu", 0777);   // échoue sans conséquence s’il existe
+    mkdir(REPLAY_DIR, 0777);
+    snprintf(path, sizeof(path), "%s/level%02d.rec", REPLAY_DIR, g_inputLog.level + 1);
+    if (!input_log_save(g_inputLog, path))
+        printf("[Replay] Écriture impossible : %s\n", path);
+}
+
+// ============================================================================
+//  RECHARGEMENT À CHAUD (mode développement, LEVEL_HOT_RELOAD)
+//  - Un stat() par seconde au plus, entre deux coups.
+//  - Pack rouvert seulement si sa date ou sa taille a changé ; niveau
+//    courant redécodé et réanalysé seulement si son contenu a changé.
+//  - Touches et caméra conservées : seul l’état du niveau est remplacé.
+// ============================================================================
+static void hot_reload_levels()
+{
+    if (++g_watchFrames < LEVEL_WATCH_FRAMES) return;
+    g_watchFrames = 0;
+    if (!levels_file_changed(LEVEL_PACK_PATH, g_packStamp)) return;
+
+    // Fichier supprimé ou en cours de copie : on attend la modification suivante
+    if (!levels_open(LEVEL_PACK_PATH)) return;
+
+    const int level = g_state.currentLevel < levels_count() ? g_state.currentLevel : 0;
+    if (!g_levels.reload(level)) return;
+
+    const Camera camera = g_camera;
+    game_load_level(level);
+    g_camera = camera;
+    printf("[Levels] Niveau %d rechargé depuis %s\n", level + 1, LEVEL_PACK_PATH);
+}
+
+// Applique une entrée au moteur (chemin commun au jeu et au rejeu hôte)
+static MoveResult game_apply(InputCode c)
+{
+    if (INPUT_RECORDING) input_log_push(g_inputLog, c);
+
+    MoveResult r = input_apply(g_state.grid, g_state.rules, g_state.props, &g_state.undo, c,
+                               &g_state.ruleEvents);
+
+    if (INPUT_RECORDING && (r.hasWon || r.hasDied)) {
+        input_log_finish(g_inputLog, g_state.grid, r.hasWon, r.hasDied);
+        save_input_log();
+    }
+    return r;
+}
+
 // ============================================================================
 //  ÉCRAN DE TITRE
 // ============================================================================
@@ -166,9 +252,10 @@ void game_show_title()
 //  game_update() — Mise à jour logique du jeu
 // ============================================================================
 void game_update() {
-	// Réinitialiser les flags à chaque frame
+	// Réinitialiser les flags et les événements de règles à chaque frame
     g_state.hasWon  = false;
     g_state.hasDied = false;
+    g_state.ruleEvents.clear();
 
     // Lecture des entrées directionnelles
     int dx = 0, dy = 0;
@@ -177,13 +264,13 @@ void game_update() {
     else if (g_keys.up)    dy = -1;
     else if (g_keys.down)  dy = +1;
 
+    // Pas de coup : vérification du pack (mode développement)
+    if (LEVEL_HOT_RELOAD && dx == 0 && dy == 0) hot_reload_levels();
+
     // Déplacement si demandé
     if (dx != 0 || dy != 0) {
-		// step() : snapshot → push → move → effects
-        MoveResult r = step(g_state.grid, g_state.props, dx, dy);
-		
-		// Recalcul des règles après chaque mouvement
-        rules_parse(g_state.grid, g_state.props);
+		// step() puis recalcul incrémental des règles (voir input_apply)
+        MoveResult r = game_apply(input_from_dir(dx, dy));
 		
 		// Mettre à jour les flags
         g_state.hasWon  = r.hasWon;
@@ -198,13 +285,20 @@ void game_update() {
    Helpers de progression (utilisés par task_game)
    =============================================================================== 
 */
+static int next_level()
+{
+    int next = g_state.currentLevel + 1;
+    return next >= levels_count() ? 0 : next;
+}
+
+void game_prefetch_next()
+{
+    g_levels.prefetch(next_level());
+}
+
 void game_win_continue() 
 { 
-    int next = g_state.currentLevel + 1; 
-    if (next >= levels_count()) {
-        next = 0;
-    } 
-    game_load_level(next); 
+    game_load_level(next_level()); 
 } 
 
 void game_restart_after_death() 
@@ -212,6 +306,30 @@ void game_restart_after_death()
     game_load_level(g_state.currentLevel); 
 }
 
+// ============================================================================
+//  Annulation / rejeu
+//  - Le journal remet la grille en place ; les règles sont recalculées
+//    sur les lignes/colonnes touchées, comme après un step().
+// ============================================================================
+bool game_undo()
+{
+    if (!g_state.undo.can_undo()) return false;
+    game_apply(INPUT_UNDO);
+    g_state.hasWon  = false;
+    g_state.hasDied = false;
+    return true;
+}
+
+bool game_redo()
+{
+    if (!g_state.undo.can_redo()) return false;
+    // Coup rejoué : victoire / mort du coup d’origine (notées au journal)
+    MoveResult r = game_apply(INPUT_REDO);
+    g_state.hasWon  = r.hasWon;
+    g_state.hasDied = r.hasDied;
+    return true;
+}
+
 /*
 ===============================================================================
   DESSIN DU JEU
@@ -24,6 +24,7 @@
 #pragma once
 #include "core/grid.h"
 #include "core/rules.h"
+#include "core/undo.h"
 
 namespace baba {
 
@@ -35,11 +36,17 @@ namespace baba {
 struct GameState {
     Grid grid;                // Grille de jeu (objets et mots)
     PropertyTable props;      // Propriétés dynamiques (YOU, PUSH, STOP, etc.)
+    RuleSet rules;            // Règles actives (mises à jour de façon incrémentale)
+    RuleEvents ruleEvents;    // Règles apparues / disparues à la dernière entrée (vidé à chaque frame)
+    UndoJournal undo;         // Historique des coups (undo/redo)
     bool hasWon  = false;     // Flag de victoire
     bool hasDied = false;     // Flag de mort
 	int currentLevel = 0; 	  // Niveau courant (pour restart/advance)
 };
 
+// Empreinte 64 bits de l’état (les propriétés se déduisent de la grille)
+inline uint64_t game_hash(const GameState& s) { return s.grid.state_hash(); }
+
 /*
 ===============================================================================
   Système d’états du jeu (Title / Playing / Win / Dead / Menu)
@@ -85,7 +92,12 @@ void fade_in(int delayMs = 30, int steps = 10);
 void fade_out(int delayMs = 30, int steps = 10);
 
 // Helpers de progression 
+void game_prefetch_next(); 			// décode le niveau suivant à l’avance (écran de victoire)
 void game_win_continue(); 			// avance au niveau suivant 
 void game_restart_after_death(); 	// relance le niveau courant
 
+// Annulation / rejeu du dernier coup (false si l’historique est vide)
+bool game_undo();
+bool game_redo();
+
 } // namespace baba
@@ -0,0 +1,244 @@
+/*
+===============================================================================
+  levelpack.cpp — Lecture, décodage et encodage des packs de niveaux
+-------------------------------------------------------------------------------
+  Rôle :
+    - Valider l’en-tête et l’index d’un pack (voir levelpack.h).
+    - Décoder le flux d’un niveau directement dans la Grid : un push par
+      objet, aucune allocation.
+    - Encoder une Grid et assembler un pack (utilisé par les outils hôtes).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#include "levelpack.h"
+#include <cstring>
+
+namespace baba {
+
+static const char PACK_MAGIC[4] = { 'B', 'L', 'V', 'P' };
+
+static void put_u16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static void put_u32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i)); }
+
+static uint16_t get_u16(const uint8_t* p) { return (uint16_t)(p[0] | p[1] << 8); }
+static uint32_t get_u32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+// -----------------------------------------------------------------------------
+//  En-tête et index
+// -----------------------------------------------------------------------------
+bool levelpack_read_header(const uint8_t* h, int& count, uint32_t& total)
+{
+    if (std::memcmp(h, PACK_MAGIC, 4) != 0 || h[4] != LEVELPACK_VERSION) return false;
+    count = h[5];
+    total = get_u32(h + 8);
+    return total >= (uint32_t)(LEVELPACK_HEADER + count * LEVELPACK_ENTRY);
+}
+
+bool levelpack_read_entry(const uint8_t* p, uint32_t total, LevelPackEntry& e)
+{
+    e.offset = get_u32(p);
+    e.size   = get_u16(p + 4);
+    e.width  = p[6];
+    e.height = p[7];
+    e.x      = p[8];
+    e.y      = p[9];
+    return e.width > 0 && e.height > 0
+        && e.x + e.width  <= MAP_WIDTH
+        && e.y + e.height <= MAP_HEIGHT
+        && e.offset <= total && e.size <= total - e.offset;
+}
+
+bool LevelPackView::open(const uint8_t* bytes, uint32_t len)
+{
+    data  = nullptr;
+    size  = 0;
+    count = 0;
+
+    int n;
+    uint32_t total;
+    if (len < (uint32_t)LEVELPACK_HEADER || !levelpack_read_header(bytes, n, total) || total > len)
+        return false;
+
+    data  = bytes;
+    size  = total;
+    count = n;
+    return true;
+}
+
+bool LevelPackView::entry(int index, LevelPackEntry& e) const
+{
+    if (index < 0 || index >= count) return false;
+    return levelpack_read_entry(data + LEVELPACK_HEADER + index * LEVELPACK_ENTRY, size, e);
+}
+
+// -----------------------------------------------------------------------------
+//  Décodage : le curseur parcourt la zone jouable ligne par ligne ; cell est
+//  l’index de la case courante dans la carte (pas de division par case)
+// -----------------------------------------------------------------------------
+static bool decode_stream(const LevelPackEntry& e, const uint8_t* stream, Grid& g)
+{
+    const int w = e.width;
+    int left = e.width * e.height;   // cases restantes
+    int col  = 0;
+    int cell = e.y * MAP_WIDTH + e.x;
+    ObjectType last = ObjectType::Empty;
+
+    // Avance le curseur de n cases (n <= left)
+    auto advance = [&](int n) {
+        left -= n;
+        col  += n;
+        cell += n;
+        while (col >= w) { col -= w; cell += MAP_WIDTH - w; }
+    };
+
+    for (const uint8_t* p = stream, *end = stream + e.size; p < end; ++p) {
+        const uint8_t op  = *p & 0xC0;
+        const int     arg = *p & 0x3F;
+
+        if (op == LEVELPACK_OP_SKIP) {
+            if (arg + 1 > left) return false;
+            advance(arg + 1);
+            continue;
+        }
+
+        if (op == LEVELPACK_OP_REPEAT) {
+            if (last == ObjectType::Empty || arg + 1 > left) return false;
+            for (int k = 0; k <= arg; ++k) {
+                if (!g.stack_push(cell, Object{ last })) return false;
+                advance(1);
+            }
+            continue;
+        }
+
+        // PLACE / STACK
+        if (arg == (int)ObjectType::Empty || arg >= (int)ObjectType::Count || left == 0)
+            return false;
+        last = (ObjectType)arg;
+        if (!g.stack_push(cell, Object{ last })) return false;
+        if (op == LEVELPACK_OP_PLACE) advance(1);
+    }
+    return true;
+}
+
+bool levelpack_decode(const LevelPackEntry& e, const uint8_t* stream, Grid& g)
+{
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMinX = e.x;
+    g.playMinY = e.y;
+    g.playMaxX = e.x + e.width  - 1;
+    g.playMaxY = e.y + e.height - 1;
+
+    if (decode_stream(e, stream, g)) return true;
+
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+//  Encodage
+// -----------------------------------------------------------------------------
+int levelpack_encode(const Grid& g, uint8_t* out, int cap)
+{
+    const int w = g.playMaxX - g.playMinX + 1;
+    const int h = g.playMaxY - g.playMinY + 1;
+    if (w <= 0 || h <= 0 || w > 255 || h > 255) return -1;
+
+    int n = 0;
+    auto emit = [&](uint8_t b) {
+        if (n < cap) out[n] = b;
+        ++n;
+    };
+
+    int skip = 0, repeat = 0;
+    ObjectType last = ObjectType::Empty;
+    auto flush = [&]() {
+        for (; skip > 0; skip -= 64)   emit((uint8_t)(LEVELPACK_OP_SKIP   | ((skip   > 64 ? 64 : skip)   - 1)));
+        for (; repeat > 0; repeat -= 64) emit((uint8_t)(LEVELPACK_OP_REPEAT | ((repeat > 64 ? 64 : repeat) - 1)));
+        skip = repeat = 0;
+    };
+
+    for (int y = g.playMinY; y <= g.playMaxY; ++y) {
+        for (int x = g.playMinX; x <= g.playMaxX; ++x) {
+            const auto objs = g.cell(x, y).objects;
+            const int count = objs.size();
+
+            if (count == 0) {
+                if (repeat) flush();
+                ++skip;
+                continue;
+            }
+
+            // Même type seul que le dernier posé : allonge la répétition
+            if (count == 1 && objs[0].type == last) {
+                ++repeat;
+                continue;
+            }
+
+            flush();
+            for (int k = 0; k < count; ++k)
+                emit((uint8_t)((k + 1 < count ? LEVELPACK_OP_STACK : LEVELPACK_OP_PLACE)
+                               | (uint8_t)objs[k].type));
+            last = objs[count - 1].type;
+            // Une pile ne se répète pas : REPEAT ne recopie qu’un objet
+            if (count > 1) last = ObjectType::Empty;
+        }
+    }
+    if (repeat) flush();   // les cases vides finales ne sont pas codées
+
+    return (n <= cap && n <= 0xFFFF) ? n : -1;
+}
+
+// -----------------------------------------------------------------------------
+//  Assemblage
+// -----------------------------------------------------------------------------
+void LevelPackBuilder::begin(uint8_t* buffer, uint32_t capacity, int levels)
+{
+    out   = buffer;
+    cap   = capacity;
+    count = levels;
+    added = 0;
+    used  = (uint32_t)(LEVELPACK_HEADER + levels * LEVELPACK_ENTRY);
+    ok    = levels >= 0 && levels <= LEVELPACK_MAX && used <= capacity;
+}
+
+bool LevelPackBuilder::add(const Grid& g)
+{
+    if (!ok || added >= count) return ok = false;
+
+    const int n = levelpack_encode(g, out + used, (int)(cap - used));
+    if (n < 0) return ok = false;
+
+    uint8_t* p = out + LEVELPACK_HEADER + added * LEVELPACK_ENTRY;
+    put_u32(p, used);
+    put_u16(p + 4, (uint16_t)n);
+    p[6] = (uint8_t)(g.playMaxX - g.playMinX + 1);
+    p[7] = (uint8_t)(g.playMaxY - g.playMinY + 1);
+    p[8] = (uint8_t)g.playMinX;
+    p[9] = (uint8_t)g.playMinY;
+    put_u16(p + 10, 0);
+
+    used += (uint32_t)n;
+    added++;
+    return true;
+}
+
+uint32_t LevelPackBuilder::finish()
+{
+    if (!ok || added != count) return 0;
+
+    std::memcpy(out, PACK_MAGIC, 4);
+    out[4] = LEVELPACK_VERSION;
+    out[5] = (uint8_t)count;
+    put_u16(out + 6, 0);
+    put_u32(out + 8, used);
+    return used;
+}
+
+} // namespace baba
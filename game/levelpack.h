@@ -0,0 +1,129 @@
+/*
+===============================================================================
+  levelpack.h — Format binaire compact des niveaux (pack .pak)
+-------------------------------------------------------------------------------
+  Rôle :
+    - Décrire le format d’un ensemble de niveaux, livré en un seul fichier
+      sur la carte SD ou en un seul tableau en flash (levels_data.cpp).
+    - Lire l’en-tête et l’index d’un pack (en mémoire ou octet par octet
+      depuis un fichier, sans dépendre de l’alignement ni du boutisme).
+    - Décoder le flux d’un niveau directement dans une Grid, sans tampon
+      intermédiaire.
+    - Encoder la zone jouable d’une Grid et assembler un pack (outils hôtes).
+
+  Format (petit-boutiste) :
+      En-tête (LEVELPACK_HEADER octets)
+        "BLVP"   magic
+        u8       version (1)
+        u8       nombre de niveaux N
+        u16      réservé (0)
+        u32      taille totale du pack (octets)
+      Index (N × LEVELPACK_ENTRY octets)
+        u32      décalage du flux (depuis le début du pack)
+        u16      taille du flux (octets)
+        u8       largeur, hauteur de la zone jouable
+        u8       x, y de la zone jouable dans la carte (MAP_WIDTH × MAP_HEIGHT)
+        u16      réservé (0)
+      Flux : un octet par opération, cases de la zone jouable parcourues
+      ligne par ligne (curseur) :
+        00tttttt  PLACE  : objet de type t dans la case, curseur + 1
+        01tttttt  STACK  : objet de type t dans la case, curseur inchangé
+                           (case à plusieurs objets, du bas vers le haut)
+        10nnnnnn  SKIP   : n + 1 cases vides
+        11nnnnnn  REPEAT : dernier type posé sur les n + 1 cases suivantes
+      Les cases vides en fin de zone ne sont pas codées.
+
+  Notes :
+    - Les types sont les valeurs de ObjectType (vocabulary.h) : l’ordre du
+      registre fixe aussi le format.
+    - Les niveaux livrés (13 × 10) tiennent en 32 à 83 octets de flux,
+      contre 130 octets en tableau brut de codes.
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#pragma once
+#include <cstdint>
+#include "core/grid.h"
+
+namespace baba {
+
+constexpr uint8_t LEVELPACK_VERSION = 1;
+constexpr int     LEVELPACK_HEADER  = 12;
+constexpr int     LEVELPACK_ENTRY   = 12;
+constexpr int     LEVELPACK_MAX     = 255;   // niveaux par pack (u8)
+
+static_assert((int)ObjectType::Count <= 64, "type codé sur 6 bits dans le flux");
+
+// Opérations du flux (2 bits de poids fort)
+enum : uint8_t {
+    LEVELPACK_OP_PLACE  = 0x00,
+    LEVELPACK_OP_STACK  = 0x40,
+    LEVELPACK_OP_SKIP   = 0x80,
+    LEVELPACK_OP_REPEAT = 0xC0,
+};
+
+// -----------------------------------------------------------------------------
+//  Entrée d’index : flux et zone jouable d’un niveau
+// -----------------------------------------------------------------------------
+struct LevelPackEntry {
+    uint32_t offset = 0;   // début du flux dans le pack
+    uint16_t size   = 0;   // octets du flux
+    uint8_t  width  = 0;   // zone jouable
+    uint8_t  height = 0;
+    uint8_t  x      = 0;   // coin haut-gauche de la zone dans la carte
+    uint8_t  y      = 0;
+};
+
+// -----------------------------------------------------------------------------
+//  Lecture
+// -----------------------------------------------------------------------------
+// En-tête : false si magic / version invalides. count et total sont remplis.
+bool levelpack_read_header(const uint8_t* h, int& count, uint32_t& total);
+
+// Entrée d’index : false si la zone sort de la carte ou le flux du pack
+bool levelpack_read_entry(const uint8_t* p, uint32_t total, LevelPackEntry& e);
+
+// Pack entier en mémoire (flash ou fichier chargé) : simple vue, sans copie
+struct LevelPackView {
+    const uint8_t* data  = nullptr;
+    uint32_t       size  = 0;
+    int            count = 0;
+
+    // Valide l’en-tête et la taille ; false = vue vide
+    bool open(const uint8_t* bytes, uint32_t len);
+
+    bool entry(int index, LevelPackEntry& e) const;
+};
+
+// Décode un flux dans g (vidée en place) : zone jouable puis objets.
+// false si le flux est invalide (type inconnu, débordement de la zone) ;
+// g est alors laissée vide.
+bool levelpack_decode(const LevelPackEntry& e, const uint8_t* stream, Grid& g);
+
+// -----------------------------------------------------------------------------
+//  Écriture (outils hôtes)
+// -----------------------------------------------------------------------------
+// Encode la zone jouable de g dans out. Retourne la taille du flux, ou -1
+// si out est trop petit ou la zone trop grande pour le format.
+int levelpack_encode(const Grid& g, uint8_t* out, int cap);
+
+// Assemble un pack dans un tampon fourni : begin(), add() par niveau, dans
+// l’ordre, puis finish() qui écrit l’en-tête et retourne la taille totale
+// (0 en cas d’échec : tampon trop petit, nombre de niveaux différent…).
+struct LevelPackBuilder {
+    uint8_t* out   = nullptr;
+    uint32_t cap   = 0;
+    uint32_t used  = 0;
+    int      count = 0;   // niveaux annoncés
+    int      added = 0;
+    bool     ok    = false;
+
+    void     begin(uint8_t* buffer, uint32_t capacity, int levels);
+    bool     add(const Grid& g);
+    uint32_t finish();
+};
+
+} // namespace baba
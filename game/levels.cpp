@@ -3,70 +3,234 @@
   levels.cpp — Chargement des niveaux
 -------------------------------------------------------------------------------
   Rôle :
-    - Charger un niveau défini dans levels_data.cpp.
-    - Chaque niveau a ses propres dimensions (width/height).
-    - Les données sont placées dans la grille logique (MAP_WIDTH × MAP_HEIGHT).
-    - Si le niveau est plus petit que la grille logique, il est centré automatiquement.
+    - Tenir le pack actif : pack intégré (vue directe sur la flash) ou pack
+      de la carte SD (chemin + index en RAM).
+    - Charger un niveau : lecture de son entrée d’index, puis décodage du
+      flux directement dans la Grid (levelpack_decode).
+    - Garder l’état initial du niveau courant (LevelSnapshot) pour le
+      recommencer par une copie, et précharger le suivant (LevelCache).
+    - Détecter la modification du pack SD (rechargement à chaud).
 
   Notes :
-    - Les données brutes des niveaux (level1 … level21) sont définies dans levels_data.cpp.
-    - Les macros (WALL, FLAG, ROCK, etc.) sont définies dans defines.h et mappent vers ObjectType.
-    - La grille logique est définie dans grid.h (MAP_WIDTH = 32, MAP_HEIGHT = 24).
+    - La zone jouable et sa position dans la carte (MAP_WIDTH × MAP_HEIGHT)
+      sont enregistrées dans le pack ; levelc (host/levelc.cpp) centre les
+      niveaux plus petits que la carte.
+    - Pack SD : le fichier est rouvert à chaque chargement, le temps de lire
+      un seul flux (LEVEL_STREAM_MAX octets au plus).
 ===============================================================================
 */
 
 #include "levels.h"
-#include "defines.h"
-#include "core/grid.h"
+#include "levelpack.h"
+#include "core/undo.h"
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
 
 namespace baba {
 
+// -----------------------------------------------------------------------------
+// Pack actif
+// -----------------------------------------------------------------------------
+static LevelPackView g_builtin;        // pack en flash (ouvert à la demande)
+static bool          g_fromFile = false;
+
+// Pack SD : chemin et index (l’en-tête ne sert qu’à l’ouverture)
+static char           g_path[64];
+static int            g_fileCount = 0;
+static LevelPackEntry g_index[LEVELS_MAX];
+static uint8_t        g_stream[LEVEL_STREAM_MAX];
+
+static const LevelPackView& builtin_pack()
+{
+    if (!g_builtin.data && !g_builtin.open(LEVEL_PACK_BUILTIN, LEVEL_PACK_BUILTIN_SIZE))
+        printf("[Levels] Pack intégré invalide\n");
+    return g_builtin;
+}
+
+bool levels_open(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+
+    // Index lu à part : le pack actif n’est touché qu’une fois tout validé
+    uint8_t        h[LEVELPACK_HEADER];
+    uint8_t        e[LEVELPACK_ENTRY];
+    LevelPackEntry index[LEVELS_MAX];
+    int count = 0;
+    uint32_t total = 0;
+    bool ok = fread(h, 1, LEVELPACK_HEADER, f) == (size_t)LEVELPACK_HEADER
+           && levelpack_read_header(h, count, total)
+           && count <= LEVELS_MAX;
+
+    for (int i = 0; ok && i < count; ++i)
+        ok = fread(e, 1, LEVELPACK_ENTRY, f) == (size_t)LEVELPACK_ENTRY
+          && levelpack_read_entry(e, total, index[i])
+          && index[i].size <= LEVEL_STREAM_MAX;
+    fclose(f);
+
+    if (!ok || std::strlen(path) >= sizeof(g_path)) {
+        printf("[Levels] Pack invalide : %s\n", path);
+        return false;
+    }
+
+    std::memcpy(g_index, index, sizeof(LevelPackEntry) * count);
+    std::strcpy(g_path, path);
+    g_fileCount = count;
+    g_fromFile  = true;
+    return true;
+}
+
+void levels_use_builtin()
+{
+    g_fromFile  = false;
+    g_fileCount = 0;
+}
+
+int levels_count()
+{
+    return g_fromFile ? g_fileCount : builtin_pack().count;
+}
+
 /*
 ===============================================================================
   load_level()
 -------------------------------------------------------------------------------
   Rôle :
-    - Charger un niveau identifié par son index.
-    - Utiliser ses dimensions propres (width/height).
-    - Placer les objets dans la grille logique avec centrage automatique.
+    - Charger un niveau identifié par son index dans le pack actif.
 
   Paramètres :
     - index : numéro du niveau à charger.
     - g     : référence vers la grille à remplir.
 
   Étapes :
-    1. Crée une grille logique vide (MAP_WIDTH × MAP_HEIGHT).
-    2. Récupère les données du niveau (LevelInfo).
-    3. Calcule le décalage pour centrer le niveau.
-    4. Copie les objets dans la grille logique.
+    1. Récupère l’entrée d’index (dimensions, position, flux).
+    2. Pack SD : relit le flux du niveau dans g_stream.
+    3. Décode le flux dans la grille, vidée en place (pas de Grid
+       temporaire : l’arène fait plusieurs Ko, trop pour la pile de la
+       tâche de jeu).
 ===============================================================================
 */
 
-void load_level(int index, Grid& g)
+bool load_level(int index, Grid& g)
 {
-	// Grille logique (32×24)
-    g = Grid(MAP_WIDTH, MAP_HEIGHT);
-
-    const LevelInfo& info = levels[index];
-
-	// Calcul du décalage pour centrer le niveau
-    int offsetX = (MAP_WIDTH  - info.width)  / 2;
-    int offsetY = (MAP_HEIGHT - info.height) / 2;
-
-    // Définir la zone jouable
-    g.playMinX = offsetX;
-    g.playMinY = offsetY;
-    g.playMaxX = offsetX + info.width  - 1;
-    g.playMaxY = offsetY + info.height - 1;
-
-    for (int y = 0; y < info.height; ++y) {
-        for (int x = 0; x < info.width; ++x) {
-            uint8_t code = info.data[y * info.width + x];
-            if (code == EMPTY) continue;
-            g.cell(offsetX + x, offsetY + y).objects.push_back({static_cast<ObjectType>(code)});
+    if (g_fromFile) {
+        if (index >= 0 && index < g_fileCount) {
+            const LevelPackEntry& e = g_index[index];
+            FILE* f = fopen(g_path, "rb");
+            bool ok = f && fseek(f, (long)e.offset, SEEK_SET) == 0
+                        && fread(g_stream, 1, e.size, f) == e.size;
+            if (f) fclose(f);
+            if (ok) return levelpack_decode(e, g_stream, g);
         }
+    } else {
+        const LevelPackView& pack = builtin_pack();
+        LevelPackEntry e;
+        if (pack.entry(index, e)) return levelpack_decode(e, pack.data + e.offset, g);
     }
+
+    printf("[Levels] Niveau %d illisible\n", index + 1);
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    return false;
 }
 
+/*
+===============================================================================
+  load_level_cached()
+-------------------------------------------------------------------------------
+  Rôle :
+    - Recommencer un niveau sans le redécoder ni réanalyser ses règles.
+
+  Notes :
+    - La copie d’une Grid est une copie d’arène (tableaux plats, aucun
+      pointeur interne) : ~20 Ko recopiés d’un bloc, six à sept fois moins
+      cher que reset + décodage + rules_update (voir host/bench_engine.cpp).
+    - L’instantané n’a pas de journal : celui de g est rétabli après la
+      copie.
+===============================================================================
+*/
+
+bool level_snapshot_fill(LevelSnapshot& snap, int index)
+{
+    if (snap.level == index) return true;
+
+    snap.level = -1;
+    snap.grid.journal = nullptr;
+    const bool ok = load_level(index, snap.grid);
+    rules_update(snap.grid, snap.rules, snap.props);
+    if (ok) snap.level = index;
+    return ok;
+}
+
+bool load_level_cached(LevelSnapshot& snap, int index, Grid& g,
+                       RuleSet& rules, PropertyTable& props)
+{
+    level_snapshot_fill(snap, index);
+
+    UndoJournal* journal = g.journal;
+    g         = snap.grid;
+    g.journal = journal;
+    if (journal) journal->clear();
+
+    rules = snap.rules;
+    props = snap.props;
+    return snap.level == index;
+}
+
+// -----------------------------------------------------------------------------
+// LevelCache
+// -----------------------------------------------------------------------------
+bool LevelCache::prefetch(int index)
+{
+    if (current->level == index) return true;   // simple recommencement
+    return level_snapshot_fill(*spare, index);
+}
+
+bool LevelCache::load(int index, Grid& g, RuleSet& rules, PropertyTable& props)
+{
+    if (current->level != index && spare->level == index) {
+        LevelSnapshot* s = current;
+        current = spare;
+        spare   = s;
+    }
+    return load_level_cached(*current, index, g, rules, props);
+}
+
+bool LevelCache::reload(int index)
+{
+    const bool     known  = current->level == index;
+    const uint64_t before = current->grid.state_hash();
+
+    spare->level = -1;
+    if (!level_snapshot_fill(*spare, index)) return false;
+
+    // Autre niveau modifié : l’état initial courant reste valable
+    if (known && spare->grid.state_hash() == before) {
+        spare->level = -1;
+        return false;
+    }
+
+    LevelSnapshot* s = current;
+    current = spare;
+    spare   = s;
+    spare->level = -1;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Surveillance du pack
+// -----------------------------------------------------------------------------
+bool levels_file_changed(const char* path, LevelFileStamp& stamp)
+{
+    struct stat st;
+    LevelFileStamp now;
+    if (stat(path, &st) == 0) {
+        now.mtime = (long long)st.st_mtime;
+        now.size  = (long long)st.st_size;
+    }
+    if (now.mtime == stamp.mtime && now.size == stamp.size) return false;
+    stamp = now;
+    return true;
+}
 
 } // namespace baba
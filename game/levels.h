@@ -1,94 +1,128 @@
 /*
 ===============================================================================
-  levels.h — Déclarations des niveaux
+  levels.h — Accès aux niveaux
 -------------------------------------------------------------------------------
   Rôle :
-    - Définir les constantes de dimensions de la carte.
-    - Déclarer les tableaux de niveaux (extern).
-    - Fournir un accès générique via levels[] et levels_count().
-    - Utilisé par load_level() dans levels.cpp pour remplir la Grid.
+    - Choisir la source des niveaux : pack sur la carte SD (levels_open) ou
+      pack intégré en flash (levels_data.cpp).
+    - Fournir levels_count() et load_level() pour remplir la Grid.
 
   Notes :
-    - Chaque niveau est codé en dur sous forme de tableau uint8_t.
-    - Les valeurs proviennent de defines.h (EMPTY, BABA, FLAG, W_BABA, W_IS…).
-    - MAP_WIDTH × MAP_HEIGHT = META_FULL_SIZE.
-    - Évolution possible : chargement dynamique depuis fichiers externes.
+    - Format des packs : voir levelpack.h (en-tête versionné, index, flux
+      compressés par niveau).
+    - Pack SD : seuls l’en-tête et l’index restent en RAM ; le flux d’un
+      niveau est relu à chaque chargement dans un petit tampon.
+    - Le nombre de niveaux vient de l’en-tête du pack : ajouter un niveau ne
+      demande plus de toucher au code.
+    - LevelSnapshot garde l’état initial décodé (grille + règles) du dernier
+      niveau chargé : recommencer ce niveau est une simple copie.
+    - LevelCache y ajoute un second instantané, rempli à l’avance avec le
+      niveau suivant (écran de victoire) : passer au niveau suivant est
+      alors aussi une simple copie.
 ===============================================================================
 */
 
 #pragma once
 #include <cstdint>
 #include "core/grid.h"
+#include "core/rules.h"
 
 namespace baba {
 
+// Niveaux d’un pack SD gardés en index (au-delà, levels_open() échoue)
+constexpr int LEVELS_MAX = 64;
+
+// Taille maximale du flux d’un niveau lu depuis la carte SD
+constexpr int LEVEL_STREAM_MAX = 1024;
+
 // -----------------------------------------------------------------------------
-// Dimensions de la carte
+// Pack intégré (défini dans levels_data.cpp)
 // -----------------------------------------------------------------------------
-// Dimensions des niveaux META
-constexpr int META_WIDTH     = 13;
-constexpr int META_HEIGHT    = 10;
-constexpr int META_FULL_SIZE = META_WIDTH * META_HEIGHT;
+extern const uint8_t  LEVEL_PACK_BUILTIN[];
+extern const uint32_t LEVEL_PACK_BUILTIN_SIZE;
 
 
-// ----------------------------------------------------------------------------- 
-// Structure LevelInfo : associe données et dimensions 
 // -----------------------------------------------------------------------------
-struct LevelInfo {
-    const uint8_t* data;   // tableau brut du niveau
-    int width;             // largeur propre au niveau
-    int height;            // hauteur propre au niveau
-};
+// Helpers
+// -----------------------------------------------------------------------------
 
+// Utilise le pack du fichier path (en-tête et index lus immédiatement).
+// false si le fichier est absent ou invalide : le pack actif (intégré au
+// démarrage) est conservé.
+bool levels_open(const char* path);
+
+// Revient au pack intégré
+void levels_use_builtin();
+
+// Nombre de niveaux du pack actif
+int levels_count();
+
+// Charge un niveau dans une Grid (vidée en place).
+// false si l’index ou les données sont invalides (grille laissée vide).
+bool load_level(int index, Grid& g);
 
 // -----------------------------------------------------------------------------
-// Déclarations des niveaux (définis dans levels.cpp)
+// État initial d’un niveau : grille décodée et règles déjà analysées
 // -----------------------------------------------------------------------------
-extern const uint8_t level1[META_FULL_SIZE];
-extern const uint8_t level2[META_FULL_SIZE];
-extern const uint8_t level3[META_FULL_SIZE];
-extern const uint8_t level4[META_FULL_SIZE];
-extern const uint8_t level5[META_FULL_SIZE];
-extern const uint8_t level6[META_FULL_SIZE];
-extern const uint8_t level7[META_FULL_SIZE];
-extern const uint8_t level8[META_FULL_SIZE];
-extern const uint8_t level9[META_FULL_SIZE];
-extern const uint8_t level10[META_FULL_SIZE];
-extern const uint8_t level11[META_FULL_SIZE];
-extern const uint8_t level12[META_FULL_SIZE];
-extern const uint8_t level13[META_FULL_SIZE];
-extern const uint8_t level14[META_FULL_SIZE];
-extern const uint8_t level15[META_FULL_SIZE];
-extern const uint8_t level16[META_FULL_SIZE];
-extern const uint8_t level17[META_FULL_SIZE];
-extern const uint8_t level18[META_FULL_SIZE];
-extern const uint8_t level19[META_FULL_SIZE];
-extern const uint8_t level20[META_FULL_SIZE];
-extern const uint8_t level21[META_FULL_SIZE];
-
-// Placeholders pour extension
-extern const uint8_t level22[META_FULL_SIZE];
-extern const uint8_t level23[META_FULL_SIZE];
-extern const uint8_t level24[META_FULL_SIZE];
-extern const uint8_t level25[META_FULL_SIZE];
+struct LevelSnapshot {
+    Grid          grid;
+    RuleSet       rules;
+    PropertyTable props;
+    int           level = -1;   // niveau contenu, -1 = aucun
+};
+
+// Charge le niveau index dans g / rules / props, règles analysées.
+// Si snap contient déjà ce niveau (recommencer après une mort), l’état est
+// recopié tel quel, sans décodage ni analyse ; sinon le niveau est décodé
+// et analysé dans snap, puis recopié. Le journal d’annulation de g est
+// conservé et vidé, comme par Grid::reset().
+bool load_level_cached(LevelSnapshot& snap, int index, Grid& g,
+                       RuleSet& rules, PropertyTable& props);
+
+// Remplit snap avec l’état initial du niveau index (décodage + analyse des
+// règles), sauf s’il le contient déjà. false si le niveau est illisible.
+bool level_snapshot_fill(LevelSnapshot& snap, int index);
 
 // -----------------------------------------------------------------------------
-// Tableau global des niveaux
+// Niveau courant + niveau préchargé
+//  - prefetch() décode un niveau dans l’instantané de réserve, hors du
+//    chemin critique (pendant l’écran de victoire).
+//  - load() échange les deux instantanés si la réserve contient le niveau
+//    demandé (échange de pointeurs), puis recopie l’état initial.
 // -----------------------------------------------------------------------------
-extern const LevelInfo levels[];
+struct LevelCache {
+    LevelSnapshot  slots[2];
+    LevelSnapshot* current = &slots[0];   // état initial du niveau en cours
+    LevelSnapshot* spare   = &slots[1];   // niveau préchargé
+
+    LevelCache() = default;
+    LevelCache(const LevelCache&) = delete;             // pointeurs internes
+    LevelCache& operator=(const LevelCache&) = delete;
 
+    bool prefetch(int index);
+    bool load(int index, Grid& g, RuleSet& rules, PropertyTable& props);
+
+    // Relit le niveau index dans le pack actif (rouvert après modification).
+    // true si son état initial a changé : il devient l’état courant et
+    // l’appelant le recharge (load). false si le niveau est identique ou
+    // illisible : l’état courant est conservé. La réserve est oubliée.
+    bool reload(int index);
+
+    // Oublie les deux instantanés (pack changé)
+    void clear() { slots[0].level = slots[1].level = -1; }
+};
 
 // -----------------------------------------------------------------------------
-// Helpers
+// Surveillance d’un fichier de pack (rechargement à chaud, mode développement)
 // -----------------------------------------------------------------------------
+struct LevelFileStamp {
+    long long mtime = -1;   // -1 = fichier absent
+    long long size  = -1;
+};
 
-// Nombre de niveaux disponibles
-inline int levels_count() {
-    // ⚠️ À mettre à jour si tu ajoutes/retires des niveaux
-    return 21; 
-}
-
-// Charge un niveau dans une Grid
-void load_level(int index, Grid& g);
+// Relève date de modification et taille de path (stat, sans lecture du
+// fichier). true si elles diffèrent de stamp (fichier apparu, disparu ou
+// modifié) ; stamp est alors mis à jour.
+bool levels_file_changed(const char* path, LevelFileStamp& stamp);
 
 } // namespace baba
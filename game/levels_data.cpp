@@ -1,331 +1,163 @@
 /*
 ===============================================================================
-  levels_data.cpp — Données des niveaux (copiées depuis META)
+  levels_data.cpp — Pack de niveaux intégré (flash)
 -------------------------------------------------------------------------------
   Rôle :
-    - Contient les définitions des niveaux sous forme de tableaux uint8_t.
-    - Chaque tableau correspond à une grille MAP_WIDTH × MAP_HEIGHT.
-    - Les valeurs proviennent de defines.h (EMPTY, BABA, FLAG, W_BABA, W_IS…).
-    - Fournit un tableau global levels[] pour accéder aux niveaux par index.
+    - Contient le pack de niveaux livré avec le jeu, au format binaire
+      décrit dans levelpack.h (en-tête, index, un flux par niveau).
+    - Utilisé par load_level() quand aucun pack n’est trouvé sur la carte SD
+      (voir levels_open()).
 
   Notes :
-    - Ces données sont copiées depuis la version META du jeu.
-    - Elles sont maintenant intégrées dans le projet AKA pour être compilées.
-    - load_level() (dans levels.cpp) utilise levels[] pour remplir la Grid.
-    - Évolution possible : remplacer ces tableaux par un format externe
-      (JSON, binaire, éditeur intégré).
+    - Fichier généré par levelc (host/levelc.cpp) depuis les cartes ASCII
+      de assets/levels/ : modifier les cartes, pas ce fichier.
+    - Mêmes octets que le fichier levels.pak : un pack copié sur la carte SD
+      remplace celui-ci sans recompiler.
+    - 1562 octets pour 21 niveaux.
 ===============================================================================
 */
 
 #include "levels.h"
-#include "defines.h"
 
 namespace baba {
 
-// -----------------------------------------------------------------------------
-// Définition des niveaux (copiés depuis META)
-// Chaque niveau est un tableau de taille META_FULL_SIZE (MAP_WIDTH × MAP_HEIGHT)
-// -----------------------------------------------------------------------------
-
-const uint8_t level1[META_FULL_SIZE] = {
-    EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-    EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-    EMPTY, EMPTY, W_FLAG, W_IS, W_WIN, EMPTY, EMPTY, EMPTY, W_WALL, W_IS, W_STOP, EMPTY, EMPTY,
-    EMPTY, EMPTY, WALL, WALL, WALL, WALL, WALL, WALL, WALL, WALL, WALL, EMPTY, EMPTY,
-    EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, ROCK, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-    EMPTY, EMPTY, BABA, EMPTY, EMPTY, EMPTY, ROCK, EMPTY, EMPTY, EMPTY, FLAG, EMPTY, EMPTY,
-    EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, ROCK, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-    EMPTY, EMPTY, WALL, WALL, WALL, WALL, WALL, WALL, WALL, WALL, WALL, EMPTY, EMPTY,
-    EMPTY, EMPTY, W_BABA, W_IS, W_YOU, EMPTY, EMPTY, EMPTY, W_ROCK, W_IS, W_PUSH, EMPTY, EMPTY,
-    EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-};
-
-const uint8_t level2[META_FULL_SIZE] = {
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, W_IS,  EMPTY, EMPTY, EMPTY, EMPTY, WALL,  
-WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, EMPTY, EMPTY, W_WIN, EMPTY, WALL,  
-WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  
-WALL,  EMPTY, W_FLAG,EMPTY, EMPTY, EMPTY, FLAG,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  
-WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, BABA,  EMPTY, EMPTY, WALL,  
-WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, W_BABA,W_IS,  W_YOU, EMPTY, EMPTY, EMPTY, W_WALL,W_IS,  W_STOP,EMPTY, EMPTY, 
-};
-
-const uint8_t level3[META_FULL_SIZE] = {
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, W_BABA,EMPTY, EMPTY, EMPTY, EMPTY, W_FLAG,WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, 
-EMPTY, W_IS,  EMPTY, EMPTY, EMPTY, EMPTY, W_IS,  WALL,  EMPTY, EMPTY, EMPTY, WALL,  EMPTY, 
-EMPTY, W_YOU, EMPTY, EMPTY, EMPTY, EMPTY, W_WIN, WALL,  EMPTY, FLAG,  EMPTY, WALL,  EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, WALL,  EMPTY, 
-EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, 
-EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, 
-EMPTY, WALL,  EMPTY, W_WALL,W_IS,  W_STOP,EMPTY, EMPTY, BABA,  EMPTY, EMPTY, WALL,  EMPTY, 
-EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, 
-EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, 
-};
-
-const uint8_t level4[META_FULL_SIZE] = {
-W_BABA,WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  W_GOOP,
-W_IS,  WALL,  EMPTY, EMPTY, EMPTY, W_ROCK,W_IS,  W_PUSH,EMPTY, EMPTY, EMPTY, WALL,  W_IS,  
-W_YOU, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  W_SINK,
-EMPTY, WALL,  EMPTY, BABA,  EMPTY, EMPTY, EMPTY, EMPTY, ROCK,  ROCK,  EMPTY, WALL,  EMPTY, 
-EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, 
-EMPTY, WALL,  WALL,  WALL,  WALL,  GOOP,  GOOP,  GOOP,  WALL,  WALL,  WALL,  WALL,  EMPTY, 
-EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, 
-W_WALL,WALL,  GOOP,  GOOP,  GOOP,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, 
-W_IS,  WALL,  GOOP,  GOOP,  GOOP,  EMPTY, EMPTY, W_FLAG,W_IS,  W_WIN, EMPTY, WALL,  EMPTY, 
-W_STOP,WALL,  FLAG,  GOOP,  GOOP,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, 
-};
-
-const uint8_t level5[META_FULL_SIZE] = {
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-W_BABA,EMPTY, EMPTY, ROCK,  EMPTY, EMPTY, EMPTY, ROCK,  EMPTY, EMPTY, EMPTY, EMPTY, W_WALL,
-W_IS,  EMPTY, W_ROCK,W_IS,  W_PUSH,EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  EMPTY, W_IS,  
-W_YOU, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  FLAG,  LAVA,  EMPTY, W_STOP,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  EMPTY, EMPTY, 
-EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, EMPTY, ROCK,  EMPTY, EMPTY, EMPTY, 
-EMPTY, WALL,  EMPTY, BABA,  EMPTY, ROCK,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, W_FLAG,
-EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, W_IS,  
-EMPTY, EMPTY, EMPTY, EMPTY, ROCK,  EMPTY, EMPTY, EMPTY, EMPTY, ROCK,  EMPTY, EMPTY, W_WIN, 
-EMPTY, W_LAVA,W_IS,  W_KILL,EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-};
-
-const uint8_t level6[META_FULL_SIZE] = {
-W_LAVA,W_IS,  W_KILL,ROCK,  EMPTY, WALL,  LAVA,  WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, 
-W_ROCK,W_IS,  W_STOP,ROCK,  EMPTY, WALL,  LAVA,  EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, 
-W_FLAG,W_IS,  W_WIN, ROCK,  EMPTY, WALL,  LAVA,  EMPTY, EMPTY, FLAG,  EMPTY, WALL,  EMPTY, 
-ROCK,  ROCK,  ROCK,  ROCK,  EMPTY, WALL,  LAVA,  EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  LAVA,  EMPTY, WALL,  WALL,  WALL,  WALL,  EMPTY, 
-EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  
-EMPTY, WALL,  BABA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, WALL,  WALL,  WALL,  WALL,  W_WALL,W_IS,  W_STOP,WALL,  EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, W_BABA,W_IS,  W_YOU, WALL,  EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, EMPTY, EMPTY, 
-};
-
-const uint8_t level7[META_FULL_SIZE] = {
-EMPTY, EMPTY, EMPTY, EMPTY, W_WALL,W_IS,  W_STOP,EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  W_BABA,W_IS,  W_YOU, EMPTY, EMPTY, W_WIN, EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, W_FLAG,EMPTY, EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  BABA,  EMPTY, EMPTY, FLAG,  EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-};
-
-const uint8_t level8[META_FULL_SIZE] = {
-EMPTY, EMPTY, WALL,  BABA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  LAVA,  LAVA,  LAVA,  EMPTY, EMPTY, W_WALL,EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, W_IS,  EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  EMPTY, W_LAVA,W_IS,  W_STOP,EMPTY, W_KILL,EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, W_FLAG,W_IS,  W_WIN, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, W_WALL,W_IS,  W_STOP,EMPTY, EMPTY, EMPTY, W_BABA,W_IS,  W_YOU, EMPTY, EMPTY, 
-};
-
-const uint8_t level9[META_FULL_SIZE] = {
-EMPTY, EMPTY, W_WALL,W_IS,  W_STOP,EMPTY, EMPTY, EMPTY, EMPTY, W_BABA,W_IS,  W_YOU, EMPTY, 
-EMPTY, WALL,  WALL,  WALL,  EMPTY, EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, 
-EMPTY, WALL,  BABA,  WALL,  EMPTY, EMPTY, WALL,  W_LOVE,EMPTY, W_WIN, WALL,  EMPTY, EMPTY, 
-EMPTY, WALL,  EMPTY, WALL,  EMPTY, EMPTY, WALL,  W_LOVE,W_IS,  W_SWAP,WALL,  EMPTY, EMPTY, 
-EMPTY, WALL,  EMPTY, WALL,  EMPTY, EMPTY, WALL,  WALL,  EMPTY, WALL,  WALL,  EMPTY, EMPTY, 
-EMPTY, WALL,  LOVE,  WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, WALL,  WALL,  EMPTY, EMPTY, 
-EMPTY, WALL,  EMPTY, ROCK,  EMPTY, EMPTY, EMPTY, LOVE,  EMPTY, EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, W_ROCK,W_IS,  W_PUSH,EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-};
-
-const uint8_t level10[META_FULL_SIZE] = {
-EMPTY, EMPTY, ROCK,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, W_FLAG,W_IS,  W_WIN, EMPTY, EMPTY, 
-W_WALL,EMPTY, ROCK,  W_LAVA,W_IS,  W_STOP,EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  
-W_IS,  EMPTY, ROCK,  EMPTY, W_LOVE,W_IS,  W_YOU, EMPTY, WALL,  LOVE,  EMPTY, EMPTY, LAVA,  
-W_STOP,EMPTY, ROCK,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  
-EMPTY, EMPTY, ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  
-EMPTY, EMPTY, W_BABA,W_IS,  W_YOU, EMPTY, ROCK,  EMPTY, W_ROCK,W_IS,  W_STOP,EMPTY, ROCK,  
-BABA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, ROCK,  LAVA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  ROCK,  EMPTY, EMPTY, EMPTY, FLAG,  EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  ROCK,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-};
-
-const uint8_t level11[META_FULL_SIZE] = {
-WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  
-WALL,  W_LAVA,W_LAVA,W_LAVA,WALL,  BABA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, GOOP,  GOOP,  
-WALL,  W_IS,  W_IS,  W_IS,  WALL,  EMPTY, WALL,  W_EMPTY,EMPTY, ROCK,  ROCK,  GOOP,  WALL,  
-WALL,  EMPTY, W_STOP,W_KILL,EMPTY, EMPTY, EMPTY, W_PUSH,EMPTY, LAVA,  LAVA,  GOOP,  WALL,  
-WALL,  EMPTY, WALL,  WALL,  WALL,  EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  GOOP,  GOOP,  WALL,  
-WALL,  EMPTY, WALL,  W_ROCK,W_IS,  EMPTY, GOOP,  GOOP,  GOOP,  GOOP,  GOOP,  GOOP,  WALL,  
-WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  GOOP,  WALL,  WALL,  WALL,  EMPTY, WALL,  WALL,  
-WALL,  W_WALL,W_IS,  W_STOP,WALL,  W_BABA,GOOP,  EMPTY, FLAG,  EMPTY, EMPTY, EMPTY, WALL,  
-WALL,  W_FLAG,W_IS,  W_WIN, WALL,  W_IS,  GOOP,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  
-WALL,  W_GOOP,W_IS,  W_SINK,WALL,  W_YOU, GOOP,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  
-};
-
-const uint8_t level12[META_FULL_SIZE] = {
-FLAG,  EMPTY, EMPTY, W_FLAG,W_BABA,W_WALL,EMPTY, EMPTY, EMPTY, EMPTY, W_ROCK,W_IS,  W_STOP,
-ROCK,  ROCK,  EMPTY, W_IS,  W_IS,  W_IS,  LAVA,  LAVA,  BABA,  EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, WALL,  W_WIN, W_YOU, W_STOP,WALL,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  EMPTY, 
-W_LAVA,EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, W_LOVE,EMPTY, ROCK,  EMPTY, 
-EMPTY, EMPTY, WALL,  W_WALL,W_IS,  W_STOP,WALL,  FLAG,  EMPTY, EMPTY, EMPTY, ROCK,  EMPTY, 
-EMPTY, EMPTY, W_PUSH,EMPTY, W_IS,  ROCK,  ROCK,  EMPTY, EMPTY, EMPTY, EMPTY, ROCK,  EMPTY, 
-EMPTY, EMPTY, ROCK,  EMPTY, EMPTY, EMPTY, ROCK,  W_LAVA,W_IS,  W_KILL,EMPTY, ROCK,  EMPTY, 
-EMPTY, EMPTY, ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  ROCK,  EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, W_IS,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, W_LOVE,EMPTY, EMPTY, EMPTY, EMPTY, W_LOVE,W_IS,  W_PUSH,EMPTY, EMPTY, W_LAVA,
-};
-
-const uint8_t level13[] = {
-W_ROCK,W_IS,  W_PUSH,EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, W_PUSH,W_LAVA,W_IS,  W_SINK,
-LAVA,  LAVA,  EMPTY, EMPTY, W_LOVE,W_IS,  W_KILL,LOVE,  EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  
-LAVA,  LAVA,  LAVA,  LAVA,  EMPTY, BABA,  EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  LAVA,  
-W_LAVA,LAVA,  LAVA,  LAVA,  LOVE,  LOVE,  LOVE,  LOVE,  LOVE,  LAVA,  LAVA,  LAVA,  W_BABA,
-W_IS,  EMPTY, LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  EMPTY, EMPTY, W_IS,  
-W_KILL,EMPTY, LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  EMPTY, W_YOU, 
-LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  
-LAVA,  FLAG,  LAVA,  LAVA,  EMPTY, LAVA,  LOVE,  LAVA,  EMPTY, LAVA,  LAVA,  EMPTY, W_FLAG,
-LAVA,  LAVA,  LAVA,  LOVE,  LOVE,  LAVA,  LAVA,  LOVE,  LOVE,  LOVE,  LAVA,  LAVA,  W_IS,  
-LAVA,  LAVA,  LAVA,  LOVE,  LAVA,  LOVE,  LAVA,  EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  W_WIN, 
-};
-
-const uint8_t level14[] = {
-EMPTY, EMPTY, WALL,  EMPTY, W_BABA,EMPTY, LAVA,  EMPTY, W_LOVE,EMPTY, WALL,  EMPTY, EMPTY, 
-BABA,  EMPTY, WALL,  EMPTY, W_IS,  EMPTY, LAVA,  EMPTY, W_IS,  EMPTY, WALL,  EMPTY, LOVE,  
-EMPTY, EMPTY, WALL,  EMPTY, W_YOU, EMPTY, LAVA,  EMPTY, W_YOU, EMPTY, WALL,  EMPTY, EMPTY, 
-EMPTY, WALL,  WALL,  EMPTY, EMPTY, EMPTY, LAVA,  EMPTY, EMPTY, EMPTY, WALL,  WALL,  EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, W_ROCK,EMPTY, EMPTY, EMPTY, LAVA,  EMPTY, EMPTY, EMPTY, W_WIN, EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, 
-W_WALL,W_IS,  W_STOP,EMPTY, EMPTY, EMPTY, LAVA,  EMPTY, EMPTY, EMPTY, W_LAVA,W_IS,  W_SINK,
-};
-
-const uint8_t level15[] = {
-BABA,  EMPTY, EMPTY, EMPTY, EMPTY, GOOP,  GOOP,  GOOP,  EMPTY, WALL,  EMPTY, EMPTY, W_LAVA,
-EMPTY, EMPTY, EMPTY, EMPTY, WALL,  GOOP,  GOOP,  W_IS,  EMPTY, EMPTY, EMPTY, EMPTY, W_IS,
-LAVA,  LAVA,  LAVA,  WALL,  WALL,  EMPTY, W_GOOP,EMPTY, W_IS,  WALL,  EMPTY, EMPTY, W_KILL,
-W_BABA,W_IS,  W_YOU, WALL,  WALL,  EMPTY, ROCK,  EMPTY, EMPTY, WALL,  W_ROCK,EMPTY, EMPTY,
-W_GOOP,W_IS,  W_SINK,WALL,  WALL,  EMPTY, BABA,  W_PUSH,EMPTY, WALL,  EMPTY, EMPTY, EMPTY,
-W_WALL,W_IS,  W_STOP,WALL,  WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-LAVA,  LAVA,  WALL,  EMPTY, GOOP,  GOOP,  GOOP,  GOOP,  GOOP,  GOOP,  GOOP,  GOOP,  GOOP,
-EMPTY, EMPTY, EMPTY, EMPTY, WALL,  GOOP,  GOOP,  GOOP,  GOOP,  GOOP,  GOOP,  GOOP,  GOOP,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, GOOP,  GOOP,  GOOP,  EMPTY, FLAG,  EMPTY, EMPTY, EMPTY,
-BABA,  EMPTY, EMPTY, EMPTY, GOOP,  GOOP,  W_FLAG,EMPTY, EMPTY, W_IS,  W_WIN, EMPTY, WALL,
-};
-
-const uint8_t level16[] = {
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  W_FLAG,
-EMPTY, W_BABA,W_IS,  W_YOU, BABA,  WALL,  EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  W_IS,
-EMPTY, EMPTY, EMPTY, EMPTY, WALL,  WALL,  EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  EMPTY, W_WIN,
-WALL,  WALL,  WALL,  EMPTY, EMPTY, ROCK,  EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  EMPTY, EMPTY,
-WALL,  W_ROCK,WALL,  WALL,  WALL,  WALL,  EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  EMPTY, EMPTY,
-EMPTY, W_IS,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  EMPTY, EMPTY,
-EMPTY, W_PUSH,EMPTY, EMPTY, W_LAVA,EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  EMPTY, EMPTY, EMPTY,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  FLAG,  EMPTY, EMPTY,
-WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, LAVA,  LAVA,  LAVA,  LAVA,  EMPTY, EMPTY, EMPTY,
-WALL,  W_LAVA,W_IS,  W_KILL,WALL,  EMPTY, LAVA,  LAVA,  LAVA,  EMPTY, W_WALL,W_IS,  W_STOP,
-};
-
-const uint8_t level17[] = {
-WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,
-WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, WALL,
-WALL,  EMPTY, EMPTY, W_BABA,W_IS,  W_YOU, EMPTY, EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,
-WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, WALL,  W_WALL,
-WALL,  EMPTY, BABA,  EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  EMPTY, FLAG,  WALL,  W_IS,
-WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, WALL,  W_STOP,
-WALL,  EMPTY, EMPTY, W_FLAG,W_IS,  W_WIN, EMPTY, EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,
-WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, WALL,
-WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-};
-
-const uint8_t level18[] = {
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-EMPTY, W_FLAG,W_IS,  W_WIN, EMPTY, WALL,  BABA,  EMPTY, LAVA,  EMPTY, EMPTY, W_WALL,EMPTY,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  LAVA,  LAVA,  LAVA,  EMPTY, EMPTY, W_IS,  EMPTY,
-EMPTY, W_BABA,W_IS,  W_YOU, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, W_STOP,EMPTY,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, W_LAVA,W_IS,  W_KILL,EMPTY, EMPTY, EMPTY,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-W_WALL,W_IS,  W_KILL,EMPTY, EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,
-};
-
-const uint8_t level19[] = {
-LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  EMPTY, LAVA,  LAVA,  LAVA,  LAVA,  W_LAVA,
-LAVA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  EMPTY, EMPTY, LAVA,  W_IS,
-LAVA,  EMPTY, W_GOOP,EMPTY, EMPTY, EMPTY, W_BABA,WALL,  WALL,  EMPTY, EMPTY, LAVA,  W_KILL,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, W_IS,  WALL,  EMPTY, EMPTY, LAVA,  LAVA,  LAVA,
-EMPTY, EMPTY, EMPTY, EMPTY, BABA,  EMPTY, W_YOU, WALL,  EMPTY, ROCK,  LAVA,  GOOP,  EMPTY,
-LAVA,  EMPTY, WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  W_FLAG,EMPTY, LAVA,  EMPTY, FLAG,
-LAVA,  EMPTY, W_WALL,W_IS,  W_STOP,EMPTY, LAVA,  LAVA,  EMPTY, EMPTY, EMPTY, LAVA,  LAVA,
-LAVA,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  EMPTY, W_IS,  EMPTY, W_ROCK,LAVA,
-LAVA,  EMPTY, LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  WALL,  W_WIN, EMPTY, EMPTY, W_IS,  LAVA,
-LAVA,  EMPTY, LAVA,  LAVA,  EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  EMPTY, EMPTY, W_YOU, LAVA,
-};
-
-const uint8_t level20[] = {
-FLAG,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,  WALL,
-EMPTY, WALL,  EMPTY, EMPTY, EMPTY, ROCK,  WALL,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-EMPTY, WALL,  EMPTY, W_LAVA,EMPTY, EMPTY, WALL,  EMPTY, W_IS,  EMPTY, EMPTY, EMPTY, EMPTY,
-EMPTY, EMPTY, WALL,  WALL,  WALL,  EMPTY, WALL,  EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  W_GOOP,
-EMPTY, EMPTY, W_IS,  EMPTY, WALL,  EMPTY, WALL,  EMPTY, W_ROCK,LAVA,  W_LAVA,LAVA,  LAVA,
-EMPTY, EMPTY, W_GOOP,EMPTY, WALL,  EMPTY, WALL,  EMPTY, EMPTY, LAVA,  W_IS,  LAVA,  W_GOOP,
-W_WIN, EMPTY, EMPTY, EMPTY, WALL,  EMPTY, WALL,  EMPTY, EMPTY, LAVA,  W_KILL,LAVA,  W_IS,
-EMPTY, EMPTY, WALL,  WALL,  EMPTY, EMPTY, EMPTY, WALL,  GOOP,  LAVA,  LAVA,  LAVA,  EMPTY,
-EMPTY, EMPTY, EMPTY, W_FLAG,EMPTY, EMPTY, EMPTY, WALL,  WALL,  WALL,  W_BABA,W_IS,  W_YOU,
-EMPTY, W_IS,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, WALL,  W_WALL,W_IS,  W_STOP,WALL,  BABA,
-};
-
-const uint8_t level21[] = {
-W_GOOP,W_IS,  W_SINK,WALL,  WALL,  WALL,  FLAG,  WALL,  WALL,  WALL,  W_BABA,W_IS,  W_YOU,
-W_WALL,W_IS,  W_STOP,WALL,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  WALL,  W_FLAG,W_IS,  W_WIN,
-WALL,  WALL,  WALL,  WALL,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  WALL,  WALL,  WALL,  WALL,
-LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  LAVA,
-EMPTY, LOVE,  EMPTY, W_FLAG,LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  EMPTY, EMPTY, EMPTY, LOVE,
-EMPTY, EMPTY, EMPTY, EMPTY, LAVA,  LAVA,  LAVA,  LAVA,  LAVA,  EMPTY, GOOP,  EMPTY, EMPTY,
-EMPTY, W_GOOP,BABA,  ROCK,  EMPTY, LAVA,  W_IS,  LAVA,  EMPTY, W_ROCK,EMPTY, EMPTY, EMPTY,
-EMPTY, EMPTY, GOOP,  EMPTY, EMPTY, EMPTY, LAVA,  EMPTY, EMPTY, LOVE,  EMPTY, ROCK,  EMPTY,
-EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, GOOP,  GOOP,  EMPTY, EMPTY, EMPTY, EMPTY, EMPTY,
-W_ROCK,W_IS,  W_PUSH,EMPTY, EMPTY, ROCK,  EMPTY, EMPTY, EMPTY, EMPTY, W_LAVA,W_IS,  W_SINK,
-};
-
-// -----------------------------------------------------------------------------
-// Tableau global des niveaux
-// -----------------------------------------------------------------------------
-const LevelInfo levels[] = { 
-	{ level1 , META_WIDTH, META_HEIGHT }, 
-	{ level2 , META_WIDTH, META_HEIGHT },
-	{ level3 , META_WIDTH, META_HEIGHT }, 
-	{ level4 , META_WIDTH, META_HEIGHT },
-	{ level5 , META_WIDTH, META_HEIGHT }, 
-	{ level6 , META_WIDTH, META_HEIGHT },
-	{ level7 , META_WIDTH, META_HEIGHT }, 
-	{ level8 , META_WIDTH, META_HEIGHT },
-	{ level9 , META_WIDTH, META_HEIGHT }, 
-	{ level10, META_WIDTH, META_HEIGHT },
-	{ level11, META_WIDTH, META_HEIGHT }, 
-	{ level12, META_WIDTH, META_HEIGHT },
-	{ level13, META_WIDTH, META_HEIGHT }, 
-	{ level14, META_WIDTH, META_HEIGHT },
-	{ level15, META_WIDTH, META_HEIGHT }, 
-	{ level16, META_WIDTH, META_HEIGHT },
-	{ level17, META_WIDTH, META_HEIGHT }, 
-	{ level18, META_WIDTH, META_HEIGHT },
-	{ level19, META_WIDTH, META_HEIGHT }, 
-	{ level20, META_WIDTH, META_HEIGHT },
-	{ level21, META_WIDTH, META_HEIGHT }
-    // placeholders level22 … level25 peuvent être ajoutés ici si définis
-};
+const uint8_t LEVEL_PACK_BUILTIN[] = {
+    // En-tête : "BLVP", version, 21 niveaux, taille totale 1562
+    0x42, 0x4C, 0x56, 0x50, 0x01, 0x15, 0x00, 0x00, 0x1A, 0x06, 0x00, 0x00,
+    // Index : décalage, taille, largeur × hauteur, position dans la carte
+    0x08, 0x01, 0x00, 0x00, 0x20, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x28, 0x01, 0x00, 0x00, 0x29, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x51, 0x01, 0x00, 0x00, 0x30, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x81, 0x01, 0x00, 0x00, 0x44, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0xC5, 0x01, 0x00, 0x00, 0x38, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0xFD, 0x01, 0x00, 0x00, 0x45, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x42, 0x02, 0x00, 0x00, 0x23, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x65, 0x02, 0x00, 0x00, 0x2F, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x94, 0x02, 0x00, 0x00, 0x3E, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0xD2, 0x02, 0x00, 0x00, 0x40, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x12, 0x03, 0x00, 0x00, 0x53, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x65, 0x03, 0x00, 0x00, 0x48, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0xAD, 0x03, 0x00, 0x00, 0x4C, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0xF9, 0x03, 0x00, 0x00, 0x41, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x3A, 0x04, 0x00, 0x00, 0x4F, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x89, 0x04, 0x00, 0x00, 0x49, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0xD2, 0x04, 0x00, 0x00, 0x2E, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x00, 0x05, 0x00, 0x00, 0x2F, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x2F, 0x05, 0x00, 0x00, 0x4F, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0x7E, 0x05, 0x00, 0x00, 0x53, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    0xD1, 0x05, 0x00, 0x00, 0x49, 0x00, 0x0D, 0x0A, 0x09, 0x07, 0x00, 0x00,
+    // Niveau 1 : level01.txt (32 octets)
+    0x9B, 0x0B, 0x10, 0x13, 0x82, 0x09, 0x10, 0x12, 0x83, 0x02, 0xC7, 0x87, 0x03, 0x87, 0x01, 0x82,
+    0x03, 0x82, 0x04, 0x87, 0x03, 0x87, 0x02, 0xC7, 0x83, 0x08, 0x10, 0x14, 0x82, 0x0A, 0x10, 0x11,
+    // Niveau 2 : level02.txt (41 octets)
+    0x84, 0x02, 0xC6, 0x84, 0xC0, 0x85, 0xC0, 0x84, 0xC0, 0x80, 0x10, 0x83, 0x02, 0xC5, 0x83, 0x13,
+    0x80, 0x02, 0xC0, 0x8A, 0xC1, 0x80, 0x0B, 0x82, 0x04, 0x84, 0x02, 0xC0, 0x87, 0x01, 0x81, 0x02,
+    0xCC, 0x8E, 0x08, 0x10, 0x14, 0x82, 0x09, 0x10, 0x12,
+    // Niveau 3 : level03.txt (48 octets)
+    0x8D, 0x08, 0x83, 0x0B, 0x02, 0xC3, 0x81, 0x10, 0x83, 0xC0, 0x02, 0x82, 0xC0, 0x81, 0x14, 0x83,
+    0x13, 0x02, 0x80, 0x04, 0x80, 0x02, 0x87, 0xC0, 0x82, 0xC0, 0x81, 0xCA, 0x81, 0xC0, 0x88, 0xC0,
+    0x81, 0xC0, 0x80, 0x09, 0x10, 0x12, 0x81, 0x01, 0x81, 0x02, 0x81, 0xC0, 0x88, 0xC0, 0x81, 0xCA,
+    // Niveau 4 : level04.txt (68 octets)
+    0x08, 0x02, 0x88, 0xC0, 0x0D, 0x10, 0x02, 0x82, 0x0A, 0x10, 0x11, 0x82, 0x02, 0x10, 0x14, 0x02,
+    0x88, 0xC0, 0x15, 0x80, 0x02, 0x80, 0x01, 0x83, 0x03, 0xC0, 0x80, 0x02, 0x81, 0xC0, 0x88, 0xC0,
+    0x81, 0xC3, 0x06, 0xC1, 0x02, 0xC2, 0x81, 0xC0, 0x88, 0xC0, 0x80, 0x09, 0x02, 0x06, 0xC1, 0x85,
+    0x02, 0x80, 0x10, 0x02, 0x06, 0xC1, 0x81, 0x0B, 0x10, 0x13, 0x80, 0x02, 0x80, 0x12, 0x02, 0x04,
+    0x06, 0xC0, 0x85, 0x02,
+    // Niveau 5 : level05.txt (56 octets)
+    0x8C, 0x08, 0x81, 0x03, 0x82, 0xC0, 0x83, 0x09, 0x10, 0x80, 0x0A, 0x10, 0x11, 0x82, 0x05, 0xC1,
+    0x80, 0x10, 0x14, 0x86, 0x05, 0x04, 0x05, 0x80, 0x12, 0x87, 0x05, 0xC1, 0x82, 0x02, 0xC3, 0x82,
+    0x03, 0x83, 0x02, 0x80, 0x01, 0x80, 0x03, 0x85, 0x0B, 0x80, 0x02, 0xC3, 0x85, 0x10, 0x83, 0x03,
+    0x83, 0xC0, 0x81, 0x13, 0x80, 0x0C, 0x10, 0x16,
+    // Niveau 6 : level06.txt (69 octets)
+    0x0C, 0x10, 0x16, 0x03, 0x80, 0x02, 0x05, 0x02, 0xC3, 0x80, 0x0A, 0x10, 0x12, 0x03, 0x80, 0x02,
+    0x05, 0x83, 0x02, 0x80, 0x0B, 0x10, 0x13, 0x03, 0x80, 0x02, 0x05, 0x81, 0x04, 0x80, 0x02, 0x80,
+    0x03, 0xC2, 0x80, 0x02, 0x05, 0x83, 0x02, 0x85, 0xC0, 0x05, 0x80, 0x02, 0xC2, 0x81, 0xC4, 0x05,
+    0xC5, 0x80, 0x02, 0x01, 0x84, 0x02, 0x84, 0xC3, 0x09, 0x10, 0x12, 0x02, 0x84, 0x08, 0x10, 0x14,
+    0x02, 0x82, 0xC0, 0x87, 0xC4,
+    // Niveau 7 : level07.txt (35 octets)
+    0x83, 0x09, 0x10, 0x12, 0xA1, 0x02, 0xC7, 0x83, 0xC0, 0x86, 0xC0, 0x83, 0xC0, 0x08, 0x10, 0x14,
+    0x81, 0x13, 0x80, 0x02, 0x83, 0xC0, 0x83, 0x0B, 0x81, 0x02, 0x83, 0xC0, 0x01, 0x81, 0x04, 0x82,
+    0x02, 0x83, 0xC8,
+    // Niveau 8 : level08.txt (47 octets)
+    0x81, 0x02, 0x01, 0x85, 0x02, 0x83, 0xC0, 0x05, 0xC1, 0x81, 0x09, 0x80, 0x02, 0x83, 0xC0, 0x84,
+    0x10, 0x80, 0x02, 0x83, 0xC0, 0x80, 0x0C, 0x10, 0x12, 0x80, 0x16, 0x80, 0x02, 0x83, 0xC0, 0x86,
+    0xC0, 0x83, 0xC8, 0x91, 0x0B, 0x10, 0x13, 0x95, 0x09, 0x10, 0x12, 0x82, 0x08, 0x10, 0x14,
+    // Niveau 9 : level09.txt (62 octets)
+    0x81, 0x09, 0x10, 0x12, 0x83, 0x08, 0x10, 0x14, 0x81, 0x02, 0xC1, 0x81, 0xC4, 0x82, 0xC0, 0x01,
+    0x02, 0x81, 0xC0, 0x0E, 0x80, 0x13, 0x02, 0x82, 0xC0, 0x80, 0xC0, 0x81, 0xC0, 0x0E, 0x10, 0x17,
+    0x02, 0x82, 0xC0, 0x80, 0xC0, 0x81, 0xC1, 0x80, 0xC1, 0x82, 0xC0, 0x07, 0x02, 0xC3, 0x80, 0xC1,
+    0x82, 0xC0, 0x80, 0x03, 0x82, 0x07, 0x81, 0x02, 0x82, 0xC9, 0x91, 0x0A, 0x10, 0x11,
+    // Niveau 10 : level10.txt (64 octets)
+    0x81, 0x03, 0x84, 0x0B, 0x10, 0x13, 0x81, 0x09, 0x80, 0x03, 0x0C, 0x10, 0x12, 0x85, 0x05, 0x10,
+    0x80, 0x03, 0x80, 0x0E, 0x10, 0x14, 0x80, 0x02, 0x07, 0x81, 0x05, 0x12, 0x80, 0x03, 0x87, 0x05,
+    0xC0, 0x81, 0x03, 0xC9, 0x81, 0x08, 0x10, 0x14, 0x80, 0x03, 0x80, 0x0A, 0x10, 0x12, 0x80, 0x03,
+    0x01, 0x84, 0x03, 0xC5, 0x85, 0xC0, 0x05, 0x89, 0xC0, 0x03, 0x82, 0x04, 0x84, 0x05, 0xC1, 0x03,
+    // Niveau 11 : level11.txt (83 octets)
+    0x02, 0xCC, 0x0C, 0xC1, 0x02, 0x01, 0x84, 0x06, 0xC0, 0x02, 0x10, 0xC1, 0x02, 0x80, 0xC0, 0x0F,
+    0x80, 0x03, 0xC0, 0x06, 0x02, 0xC0, 0x80, 0x12, 0x16, 0x82, 0x11, 0x80, 0x05, 0xC0, 0x06, 0x02,
+    0xC0, 0x80, 0xC2, 0x83, 0x05, 0x06, 0xC0, 0x02, 0xC0, 0x80, 0xC0, 0x0A, 0x10, 0x80, 0x06, 0xC4,
+    0x02, 0xC5, 0x06, 0x02, 0xC1, 0x80, 0xC2, 0x09, 0x10, 0x12, 0x02, 0x08, 0x06, 0x80, 0x04, 0x82,
+    0x02, 0xC0, 0x0B, 0x10, 0x13, 0x02, 0x10, 0x06, 0x84, 0x02, 0xC0, 0x0D, 0x10, 0x15, 0x02, 0x14,
+    0x06, 0x02, 0xC4,
+    // Niveau 12 : level12.txt (72 octets)
+    0x04, 0x81, 0x0B, 0x08, 0x09, 0x83, 0x0A, 0x10, 0x12, 0x03, 0xC0, 0x80, 0x10, 0xC1, 0x05, 0xC0,
+    0x01, 0x85, 0x02, 0x13, 0x14, 0x12, 0x02, 0x03, 0xC3, 0x80, 0x0C, 0x80, 0x02, 0xC3, 0x81, 0x0E,
+    0x80, 0x03, 0x82, 0x02, 0x09, 0x10, 0x12, 0x02, 0x04, 0x82, 0x03, 0x82, 0x11, 0x80, 0x10, 0x03,
+    0xC0, 0x83, 0xC0, 0x82, 0xC0, 0x82, 0xC0, 0x0C, 0x10, 0x16, 0x80, 0x03, 0x82, 0xC9, 0x84, 0x10,
+    0x89, 0x0E, 0x83, 0xC0, 0x10, 0x11, 0x81, 0x0C,
+    // Niveau 13 : level13.txt (76 octets)
+    0x0A, 0x10, 0x11, 0x85, 0xC0, 0x0C, 0x10, 0x15, 0x05, 0xC0, 0x81, 0x0E, 0x10, 0x16, 0x07, 0x82,
+    0x05, 0xC4, 0x80, 0x01, 0x82, 0x05, 0xC2, 0x0C, 0x05, 0xC1, 0x07, 0xC3, 0x05, 0xC1, 0x08, 0x10,
+    0x80, 0x05, 0xC6, 0x81, 0x10, 0x16, 0x80, 0x05, 0xC7, 0x80, 0x14, 0x05, 0xCC, 0x04, 0x05, 0xC0,
+    0x80, 0xC0, 0x07, 0x05, 0x80, 0xC1, 0x80, 0x0B, 0x05, 0xC1, 0x07, 0xC0, 0x05, 0xC0, 0x07, 0xC1,
+    0x05, 0xC0, 0x10, 0x05, 0xC1, 0x07, 0x05, 0x07, 0x05, 0x82, 0xC1, 0x13,
+    // Niveau 14 : level14.txt (65 octets)
+    0x81, 0x02, 0x80, 0x08, 0x80, 0x05, 0x80, 0x0E, 0x80, 0x02, 0x81, 0x01, 0x80, 0x02, 0x80, 0x10,
+    0x80, 0x05, 0x80, 0x10, 0x80, 0x02, 0x80, 0x07, 0x81, 0x02, 0x80, 0x14, 0x80, 0x05, 0x80, 0x14,
+    0x80, 0x02, 0x82, 0xC1, 0x82, 0x05, 0x82, 0x02, 0xC0, 0x86, 0x05, 0x8B, 0xC0, 0x87, 0x0A, 0x82,
+    0x05, 0x82, 0x13, 0x87, 0x05, 0x8B, 0xC0, 0x85, 0x09, 0x10, 0x12, 0x82, 0x05, 0x82, 0x0C, 0x10,
+    0x15,
+    // Niveau 15 : level15.txt (79 octets)
+    0x01, 0x83, 0x06, 0xC1, 0x80, 0x02, 0x81, 0x0C, 0x83, 0x02, 0x06, 0xC0, 0x10, 0x83, 0xC0, 0x05,
+    0xC1, 0x02, 0xC0, 0x80, 0x0D, 0x80, 0x10, 0x02, 0x81, 0x16, 0x08, 0x10, 0x14, 0x02, 0xC0, 0x80,
+    0x03, 0x81, 0x02, 0x0A, 0x81, 0x0D, 0x10, 0x15, 0x02, 0xC0, 0x80, 0x01, 0x11, 0x80, 0x02, 0x82,
+    0x09, 0x10, 0x12, 0x02, 0xC0, 0x87, 0x05, 0xC0, 0x02, 0x80, 0x06, 0xC7, 0x83, 0x02, 0x06, 0xC6,
+    0x84, 0xC2, 0x80, 0x04, 0x82, 0x01, 0x82, 0x06, 0xC0, 0x0B, 0x81, 0x10, 0x13, 0x80, 0x02,
+    // Niveau 16 : level16.txt (73 octets)
+    0x84, 0x02, 0x82, 0x05, 0xC1, 0x0B, 0x80, 0x08, 0x10, 0x14, 0x01, 0x02, 0x82, 0x05, 0xC1, 0x10,
+    0x83, 0x02, 0xC0, 0x81, 0x05, 0xC1, 0x80, 0x13, 0x02, 0xC1, 0x81, 0x03, 0x81, 0x05, 0xC1, 0x81,
+    0x02, 0x0A, 0x02, 0xC2, 0x81, 0x05, 0xC1, 0x82, 0x10, 0x85, 0x05, 0xC1, 0x82, 0x11, 0x81, 0x0C,
+    0x82, 0x05, 0xC0, 0x89, 0xC2, 0x04, 0x81, 0x02, 0xC3, 0x80, 0x05, 0xC2, 0x82, 0x02, 0x0C, 0x10,
+    0x16, 0x02, 0x80, 0x05, 0xC1, 0x80, 0x09, 0x10, 0x12,
+    // Niveau 17 : level17.txt (46 octets)
+    0x02, 0xCC, 0x86, 0xC0, 0x82, 0xC1, 0x81, 0x08, 0x10, 0x14, 0x81, 0x02, 0xC4, 0x86, 0xC0, 0x81,
+    0xC0, 0x09, 0x02, 0x80, 0x01, 0x80, 0x02, 0xC3, 0x80, 0x04, 0x02, 0x10, 0x02, 0x86, 0xC0, 0x81,
+    0xC0, 0x12, 0x02, 0x81, 0x0B, 0x10, 0x13, 0x81, 0x02, 0xC4, 0x86, 0xC0, 0x82, 0xCD,
+    // Niveau 18 : level18.txt (47 octets)
+    0x91, 0x02, 0xC6, 0x84, 0xC0, 0x87, 0x0B, 0x10, 0x13, 0x80, 0x02, 0x01, 0x80, 0x05, 0x81, 0x09,
+    0x85, 0x02, 0x05, 0xC1, 0x81, 0x10, 0x81, 0x08, 0x10, 0x14, 0x80, 0x02, 0x84, 0x12, 0x85, 0x02,
+    0x8B, 0xC0, 0x80, 0x0C, 0x10, 0x16, 0x87, 0x02, 0x86, 0x09, 0x10, 0x16, 0x81, 0x02, 0xC6,
+    // Niveau 19 : level19.txt (79 octets)
+    0x05, 0xC5, 0x80, 0xC3, 0x0C, 0x05, 0x85, 0xC1, 0x81, 0xC0, 0x10, 0x05, 0x80, 0x0D, 0x82, 0x08,
+    0x02, 0xC0, 0x81, 0x05, 0x16, 0x85, 0x10, 0x02, 0x81, 0x05, 0xC1, 0x83, 0x01, 0x80, 0x14, 0x02,
+    0x80, 0x03, 0x05, 0x06, 0x80, 0x05, 0x80, 0x02, 0xC4, 0x0B, 0x80, 0x05, 0x80, 0x04, 0x05, 0x80,
+    0x09, 0x10, 0x12, 0x80, 0x05, 0xC0, 0x82, 0xC2, 0x84, 0xC1, 0x80, 0x10, 0x80, 0x0A, 0x05, 0xC0,
+    0x80, 0xC4, 0x02, 0x13, 0x81, 0x10, 0x05, 0xC0, 0x80, 0xC1, 0x81, 0xC2, 0x81, 0x14, 0x05,
+    // Niveau 20 : level20.txt (83 octets)
+    0x04, 0x02, 0xCA, 0x80, 0xC0, 0x82, 0x03, 0x02, 0x86, 0xC0, 0x80, 0x0C, 0x81, 0x02, 0x80, 0x10,
+    0x85, 0x02, 0xC1, 0x80, 0xC0, 0x81, 0x05, 0xC1, 0x0D, 0x81, 0x10, 0x80, 0x02, 0x80, 0xC0, 0x80,
+    0x0A, 0x05, 0x0C, 0x05, 0xC0, 0x81, 0x0D, 0x80, 0x02, 0x80, 0xC0, 0x81, 0x05, 0x10, 0x05, 0x0D,
+    0x13, 0x82, 0x02, 0x80, 0xC0, 0x81, 0x05, 0x16, 0x05, 0x10, 0x81, 0x02, 0xC0, 0x82, 0xC0, 0x06,
+    0x05, 0xC1, 0x83, 0x0B, 0x82, 0x02, 0xC1, 0x08, 0x10, 0x14, 0x80, 0x10, 0x84, 0x02, 0x09, 0x10,
+    0x12, 0x02, 0x01,
+    // Niveau 21 : level21.txt (73 octets)
+    0x0D, 0x10, 0x15, 0x02, 0xC1, 0x04, 0x02, 0xC1, 0x08, 0x10, 0x14, 0x09, 0x10, 0x12, 0x02, 0x05,
+    0xC3, 0x02, 0x0B, 0x10, 0x13, 0x02, 0xC2, 0x05, 0xC3, 0x02, 0xC2, 0x05, 0xCB, 0x80, 0x07, 0x80,
+    0x0B, 0x05, 0xC3, 0x82, 0x07, 0x83, 0x05, 0xC3, 0x80, 0x06, 0x82, 0x0D, 0x01, 0x03, 0x80, 0x05,
+    0x10, 0x05, 0x80, 0x0A, 0x84, 0x06, 0x82, 0x05, 0x81, 0x07, 0x80, 0x03, 0x86, 0x06, 0xC0, 0x84,
+    0x0A, 0x10, 0x11, 0x81, 0x03, 0x83, 0x0C, 0x10, 0x15,
+};
+
+const uint32_t LEVEL_PACK_BUILTIN_SIZE = sizeof(LEVEL_PACK_BUILTIN);
 
 } // namespace baba
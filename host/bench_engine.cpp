@@ -0,0 +1,260 @@
+/*
+===============================================================================
+  bench_engine.cpp — Benchmark hôte du moteur (ns/op et allocations/op)
+-------------------------------------------------------------------------------
+  Rôle :
+    - Mesurer, pour chaque niveau livré, le coût des trois opérations du
+      moteur appelées par la tâche de jeu :
+        * load_level()  : chargement du niveau dans une grille existante
+        * rules_parse() : analyse complète des règles
+        * step()        : un coup, dans chacune des 4 directions, depuis
+                          l’état initial du niveau
+    - Compter les allocations dynamiques (operator new) par opération :
+      la cible n’en veut aucune dans la boucle de jeu. Le programme
+      échoue (code 1) si step() alloue, ne serait-ce qu’une fois. La
+      vérification sur des coups enchaînés (MOVE en lots, transformations,
+      HAS, débordement, undo) est faite par test_engine (ctest).
+    - Mesurer la latence de « recommencer » (mort, restart) : avant,
+      load_level() + rules_update() ; après, copie de l’état initial gardé
+      par load_level_cached(). Les deux chemins doivent donner le même état.
+    - Mesurer le passage au niveau suivant après préchargement
+      (LevelCache::prefetch pendant l’écran de victoire, puis load).
+
+  Méthode :
+    - load_level / rules_parse : N appels consécutifs chronométrés en bloc.
+    - step : avant chaque coup, l’état initial est recopié (memcpy de la
+      grille, hors chronométrage) ; chaque coup est chronométré seul et le
+      coût d’une mesure à vide est retranché.
+
+  Utilisation :
+    bench_engine [itérations]      (défaut : 20000)
+
+  Compilation : voir host/CMakeLists.txt (cible bench_engine).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "core/grid.h"
+#include "core/rules.h"
+#include "core/movement.h"
+#include "game/levels.h"
+
+using namespace baba;
+
+// ============================================================================
+//  Compteur d’allocations (remplace l’operator new global du programme)
+// ============================================================================
+static std::atomic<uint64_t> g_allocs{0};
+
+void* operator new(size_t n)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t n)                   { return operator new(n); }
+void  operator delete(void* p) noexcept          { std::free(p); }
+void  operator delete[](void* p) noexcept        { std::free(p); }
+void  operator delete(void* p, size_t) noexcept  { std::free(p); }
+void  operator delete[](void* p, size_t) noexcept{ std::free(p); }
+
+// ============================================================================
+//  Mesure
+// ============================================================================
+using Clock = std::chrono::steady_clock;
+
+static inline int64_t ns_since(Clock::time_point t0)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+}
+
+struct Stat {
+    double ns     = 0.0;   // par opération
+    double allocs = 0.0;   // par opération
+};
+
+// Coût d’une mesure à vide (deux lectures d’horloge)
+static double clock_overhead()
+{
+    const int N = 100000;
+    int64_t total = 0;
+    for (int i = 0; i < N; ++i) {
+        auto t0 = Clock::now();
+        total += ns_since(t0);
+    }
+    return (double)total / N;
+}
+
+// ============================================================================
+//  Recommencer un niveau : décodage + analyse contre copie de l’état initial
+// ============================================================================
+struct RestartStat {
+    double decodeNs = 0.0;   // load_level() + rules_update()
+    double copyNs   = 0.0;   // load_level_cached(), instantané déjà rempli
+    double nextNs   = 0.0;   // LevelCache::load() du niveau préchargé
+    double allocs   = 0.0;
+    bool   same     = true;
+};
+
+static RestartStat bench_restart(int level, int N)
+{
+    static Grid g;
+    static LevelSnapshot snap;
+    static RuleSet rules, cachedRules;
+    static PropertyTable props, cachedProps;
+    RestartStat r;
+
+    auto t0 = Clock::now();
+    for (int i = 0; i < N; ++i) {
+        load_level(level, g);
+        rules_update(g, rules, props);
+    }
+    r.decodeNs = (double)ns_since(t0) / N;
+    const uint64_t hash = g.state_hash();
+
+    load_level_cached(snap, level, g, cachedRules, cachedProps);   // remplit snap
+    const uint64_t a0 = g_allocs.load();
+    t0 = Clock::now();
+    for (int i = 0; i < N; ++i) load_level_cached(snap, level, g, cachedRules, cachedProps);
+    r.copyNs = (double)ns_since(t0) / N;
+    r.allocs = (double)(g_allocs.load() - a0) / N;
+
+    r.same = g.state_hash() == hash && g.dirtyRows == 0 && g.dirtyCols == 0
+          && cachedRules.count == rules.count
+          && cachedProps.flags == props.flags && cachedProps.types == props.types;
+
+    // Niveau suivant préchargé : alternance level / next, le préchargement
+    // (hors chronométrage) remplit la réserve, load() l’échange et la recopie
+    static LevelCache cache;
+    const int next = (level + 1) % levels_count();
+    const int pair[2] = { level, next };
+    cache.clear();
+    cache.load(level, g, cachedRules, cachedProps);
+    int64_t total = 0;
+    int lv = level;
+    for (int i = 0; i < N; ++i) {
+        lv = pair[(i + 1) & 1];
+        cache.prefetch(lv);
+        auto s0 = Clock::now();
+        cache.load(lv, g, cachedRules, cachedProps);
+        total += ns_since(s0);
+    }
+    r.nextNs = (double)total / N;
+
+    static Grid direct;
+    load_level(lv, direct);
+    r.same &= g.state_hash() == direct.state_hash();
+    return r;
+}
+
+static const int  DIRS[4][2]  = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+static const char* DIR_NAME[4] = { "L", "R", "U", "D" };
+
+int main(int argc, char** argv)
+{
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const double overhead = clock_overhead();
+
+    // Statiques : une grille fait plus de 10 Ko
+    static Grid base, work;
+    PropertyTable props;
+
+    printf("bench_engine — %d itérations, mesure à vide %.1f ns (retranchée)\n", N, overhead);
+    printf("%-6s | %9s %6s | %9s %6s |", "level", "load", "alloc", "parse", "alloc");
+    for (const char* d : DIR_NAME) printf(" %7s%-2s", "step ", d);
+    printf(" %6s\n", "alloc");
+    printf("       | %9s %6s | %9s %6s |", "(ns/op)", "(/op)", "(ns/op)", "(/op)");
+    for (int d = 0; d < 4; ++d) printf(" %9s", "(ns/op)");
+    printf(" %6s\n", "(/op)");
+
+    Stat sumLoad, sumParse, sumStep[4];
+    double sumStepAllocs = 0.0;
+    uint64_t stepAllocTotal = 0;
+
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        Stat load, parse, steps[4];
+        double stepAllocs = 0.0;
+
+        // load_level()
+        uint64_t a0 = g_allocs.load();
+        auto t0 = Clock::now();
+        for (int i = 0; i < N; ++i) load_level(lv, work);
+        load.ns     = (double)ns_since(t0) / N;
+        load.allocs = (double)(g_allocs.load() - a0) / N;
+
+        // rules_parse()
+        load_level(lv, base);
+        a0 = g_allocs.load();
+        t0 = Clock::now();
+        for (int i = 0; i < N; ++i) rules_parse(base, props);
+        parse.ns     = (double)ns_since(t0) / N;
+        parse.allocs = (double)(g_allocs.load() - a0) / N;
+
+        // step(), par direction, depuis l’état initial
+        for (int d = 0; d < 4; ++d) {
+            int64_t total = 0;
+            uint64_t allocs = 0;
+            for (int i = 0; i < N; ++i) {
+                work = base;
+                uint64_t b0 = g_allocs.load();
+                auto s0 = Clock::now();
+                step(work, props, DIRS[d][0], DIRS[d][1]);
+                total  += ns_since(s0);
+                allocs += g_allocs.load() - b0;
+            }
+            stepAllocTotal += allocs;
+            steps[d].ns     = (double)total / N - overhead;
+            steps[d].allocs = (double)allocs / N;
+            stepAllocs += steps[d].allocs / 4;
+        }
+
+        printf("%-6d | %9.1f %6.2f | %9.1f %6.2f |", lv + 1,
+               load.ns, load.allocs, parse.ns, parse.allocs);
+        for (int d = 0; d < 4; ++d) printf(" %9.1f", steps[d].ns);
+        printf(" %6.2f\n", stepAllocs);
+
+        sumLoad.ns  += load.ns;   sumLoad.allocs  += load.allocs;
+        sumParse.ns += parse.ns;  sumParse.allocs += parse.allocs;
+        for (int d = 0; d < 4; ++d) sumStep[d].ns += steps[d].ns;
+        sumStepAllocs += stepAllocs;
+    }
+
+    const double L = levels_count();
+    printf("%-6s | %9.1f %6.2f | %9.1f %6.2f |", "mean",
+           sumLoad.ns / L, sumLoad.allocs / L, sumParse.ns / L, sumParse.allocs / L);
+    for (int d = 0; d < 4; ++d) printf(" %9.1f", sumStep[d].ns / L);
+    printf(" %6.2f\n", sumStepAllocs / L);
+
+    if (stepAllocTotal) {
+        printf("ÉCHEC : %llu allocation(s) pendant step()\n", (unsigned long long)stepAllocTotal);
+        return 1;
+    }
+    printf("step() : aucune allocation\n");
+
+    // Recommencer un niveau
+    RestartStat restart;
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        RestartStat r = bench_restart(lv, N);
+        restart.decodeNs += r.decodeNs / L;
+        restart.copyNs   += r.copyNs / L;
+        restart.nextNs   += r.nextNs / L;
+        restart.allocs   += r.allocs / L;
+        restart.same     &= r.same;
+    }
+    printf("restart : décodage + analyse %.1f ns, copie de l’état initial %.1f ns (x%.1f),"
+           " %.2f alloc/op, état identique (%s)\n",
+           restart.decodeNs, restart.copyNs, restart.decodeNs / restart.copyNs,
+           restart.allocs, restart.same ? "ok" : "DIFF");
+    printf("niveau suivant : chargement %.1f ns, après préchargement %.1f ns (x%.1f)\n",
+           restart.decodeNs, restart.nextNs, restart.decodeNs / restart.nextNs);
+    return restart.same ? 0 : 1;
+}
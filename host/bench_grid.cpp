@@ -0,0 +1,314 @@
+/*
+===============================================================================
+  bench_grid.cpp — Benchmark hôte : arène plate vs vector<vector<Object>>
+-------------------------------------------------------------------------------
+  Rôle :
+    - Comparer le débit de step() et de l’analyse des règles entre le
+      stockage actuel de la grille (arène plate, core/grid.h) et l’ancien
+      stockage (un std::vector<Object> par case, fixtures.h), sur les
+      niveaux livrés.
+    - Mesurer l’analyse incrémentale (rules_update) face à l’analyse
+      complète (rules_parse).
+    - Mesurer le coût par frame de la recherche du premier YOU (caméra,
+      appelée à chaque frame de la tâche de jeu à 40 FPS) : parcours complet
+      de la carte contre requête sur l’index par type de la grille.
+    - Mesurer le recalcul complet de l’empreinte Zobrist (référence de la
+      valeur tenue à jour par la grille) et le coût d’un undo.
+    - Mesurer la résolution groupée des YOU sur un niveau de stress
+      (160 YOU poussables, chaînes bloquées) face à la référence qui
+      reparcourt chaque chaîne pour chaque YOU.
+    - Mesurer la phase MOVE (60 objets MOVE).
+    - Mesurer la passe incrémentale des interactions et des effets
+      WIN / KILL face à une passe complète.
+    - Mesurer load_level() depuis le pack intégré.
+    - Mesures seules : les vérifications (mêmes états, mêmes tables,
+      annulation, pack…) sont dans test_engine (ctest).
+
+  Méthode :
+    - Chaque niveau est chargé dans les deux grilles.
+    - Une même suite pseudo-aléatoire de directions est jouée sur les deux ;
+      sur victoire/mort, le niveau est rechargé.
+    - step(), rules_update() et rules_parse() sont chronométrés séparément.
+
+  Compilation : voir host/CMakeLists.txt (cible bench_grid).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "fixtures.h"
+
+struct Timing {
+    int64_t stepNs  = 0;
+    int64_t rulesNs = 0;   // analyse des règles utilisée par le moteur
+    int64_t fullNs  = 0;   // arène : analyse complète (référence)
+    long    ops     = 0;
+    int64_t youScanNs = 0;      // premier YOU : parcours des 768 cases
+    int64_t youIdxNs  = 0;      // premier YOU : index par type
+    int64_t hashNs = 0;         // recalcul complet de l’empreinte
+};
+
+// ============================================================================
+//  Arène : règles incrémentales (rules_update)
+//  extra = true : passe séparée qui chronomètre aussi rules_parse(), la
+//  recherche du premier YOU et le recalcul de l’empreinte (hors passe de
+//  mesure principale, pour ne pas polluer les caches pendant la mesure de
+//  step()).
+// ============================================================================
+static Timing run_flat(Grid& g, int level, int moves, bool extra)
+{
+    Timing t;
+    Lcg rng{ 1234u + (uint32_t)level };
+    static RuleSet rules;
+    PropertyTable props, full;
+
+    load_level(level, g);
+    rules_update(g, rules, props);
+
+    for (int i = 0; i < moves; ++i) {
+        const int* d = DIRS[rng.next() & 3];
+
+        auto t0 = Clock::now();
+        MoveResult r = step(g, props, d[0], d[1]);
+        t.stepNs += ns_since(t0);
+
+        t0 = Clock::now();
+        rules_update(g, rules, props);
+        t.rulesNs += ns_since(t0);
+
+        t.ops++;
+
+        if (extra) {
+            t0 = Clock::now();
+            rules_parse(g, full);
+            t.fullNs += ns_since(t0);
+
+            // Recherche du premier YOU, répétée pour dépasser la résolution
+            // de l’horloge (une par frame sur la cible)
+            constexpr int REPS = 16;
+            int a = -1, b = -1;
+            t0 = Clock::now();
+            for (int k = 0; k < REPS; ++k) { a = find_you_scan(g, props); asm volatile("" :: "r"(a)); }
+            t.youScanNs += ns_since(t0) / REPS;
+            t0 = Clock::now();
+            for (int k = 0; k < REPS; ++k) { b = g.first_cell_with(props.types_with(PROP_YOU)); asm volatile("" :: "r"(b)); }
+            t.youIdxNs += ns_since(t0) / REPS;
+
+            // Recalcul complet de l’empreinte
+            t0 = Clock::now();
+            uint64_t h = g.compute_hash();
+            t.hashNs += ns_since(t0);
+            asm volatile("" :: "r"(h));
+        }
+
+        if (r.hasWon || r.hasDied) {
+            load_level(level, g);
+            rules_update(g, rules, props);
+        }
+    }
+    return t;
+}
+
+// Ancien stockage : analyse complète à chaque coup (comportement d’origine)
+static Timing run_legacy(legacy::Grid& g, int level, int moves)
+{
+    Timing t;
+    Lcg rng{ 1234u + (uint32_t)level };
+    legacy::PropertyTable props;
+
+    legacy::load_level(level, g);
+    legacy::rules_parse(g, props);
+
+    for (int i = 0; i < moves; ++i) {
+        const int* d = DIRS[rng.next() & 3];
+
+        auto t0 = Clock::now();
+        MoveResult r = legacy::step(g, props, d[0], d[1]);
+        t.stepNs += ns_since(t0);
+
+        t0 = Clock::now();
+        legacy::rules_parse(g, props);
+        t.rulesNs += ns_since(t0);
+        t.ops++;
+
+        if (r.hasWon || r.hasDied) {
+            legacy::load_level(level, g);
+            legacy::rules_parse(g, props);
+        }
+    }
+    return t;
+}
+
+// ============================================================================
+//  Niveau de stress (build_stress, fixtures.h) : un coup par direction
+//  depuis l’état initial, sur les deux moteurs
+// ============================================================================
+static void run_stress(int reps)
+{
+    static Grid base, work;
+    static legacy::Grid oldBase, oldWork;
+    PropertyTable props;
+    legacy::PropertyTable oldProps;
+
+    base.reset(MAP_WIDTH, MAP_HEIGHT);
+    build_stress(base);
+    rules_parse(base, props);
+    oldBase = legacy::Grid(MAP_WIDTH, MAP_HEIGHT);
+    build_stress(oldBase);
+    legacy::rules_parse(oldBase, oldProps);
+
+    int yous = 0;
+    base.cells_with(props.types_with(PROP_YOU)).for_each([&](int) { yous++; });
+
+    static const char* NAME[4] = { "L", "R", "U", "D" };
+    printf("stress : %d cases YOU\n", yous);
+    for (int d = 0; d < 4; ++d) {
+        int64_t flatNs = 0, oldNs = 0;
+        for (int i = 0; i < reps; ++i) {
+            work = base;
+            auto t0 = Clock::now();
+            step(work, props, DIRS[d][0], DIRS[d][1]);
+            flatNs += ns_since(t0);
+
+            oldWork = oldBase;
+            t0 = Clock::now();
+            legacy::step(oldWork, oldProps, DIRS[d][0], DIRS[d][1]);
+            oldNs += ns_since(t0);
+        }
+        printf("  step %s : groupé %8.1f ns, référence %9.1f ns\n", NAME[d],
+               (double)flatNs / reps, (double)oldNs / reps);
+    }
+}
+
+// ============================================================================
+//  Phase MOVE : rochers MOVE (build_movers, fixtures.h), coups aléatoires
+// ============================================================================
+static void run_move(int turns)
+{
+    static Grid g;
+    static RuleSet rules;
+    PropertyTable props;
+
+    build_movers(g);
+    rules.count = 0;
+    rules_update(g, rules, props);
+
+    int movers = 0;
+    g.cells_with(props.types_with(PROP_MOVE)).for_each([&](int i) { movers += g.cell_at(i).objects.size(); });
+
+    int64_t ns = 0;
+    Lcg rng{ 99u };
+    for (int i = 0; i < turns; ++i) {
+        const int* d = DIRS[rng.next() & 3];
+        auto t0 = Clock::now();
+        step(g, props, d[0], d[1]);
+        ns += ns_since(t0);
+        rules_update(g, rules, props);
+    }
+
+    const double perStep = (double)ns / turns;
+    printf("move : %d objets MOVE, %d coups, %.1f ns/coup (%.3f %% d’une frame à 40 FPS)\n",
+           movers, turns, perStep, perStep / 25e6 * 100.0);
+}
+
+int main(int argc, char** argv)
+{
+    int moves = (argc > 1) ? std::atoi(argv[1]) : 20000;
+
+    static Grid          flat;     // statique : l’arène fait plusieurs Ko
+    static legacy::Grid  old;
+
+    printf("bench_grid — %d coups par niveau\n", moves);
+    printf("%-6s | %10s %10s | %10s %10s %10s\n",
+           "level", "step flat", "step vec", "rules inc", "rules full", "rules vec");
+    printf("       | %10s %10s | %10s %10s %10s\n",
+           "(ns/op)", "(ns/op)", "(ns/op)", "(ns/op)", "(ns/op)");
+
+    Timing sumFlat, sumOld;
+
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        Timing a = run_flat(flat, lv, moves, false);
+        Timing b = run_legacy(old, lv, moves);
+
+        Timing v = run_flat(flat, lv, moves, true);
+        a.fullNs = v.fullNs;
+        sumFlat.hashNs    += v.hashNs;
+        sumFlat.youScanNs += v.youScanNs;
+        sumFlat.youIdxNs  += v.youIdxNs;
+
+        printf("%-6d | %10.1f %10.1f | %10.1f %10.1f %10.1f\n", lv + 1,
+               (double)a.stepNs / a.ops, (double)b.stepNs / b.ops,
+               (double)a.rulesNs / a.ops, (double)a.fullNs / a.ops, (double)b.rulesNs / b.ops);
+
+        sumFlat.stepNs += a.stepNs; sumFlat.rulesNs += a.rulesNs; sumFlat.fullNs += a.fullNs;
+        sumFlat.ops    += a.ops;
+        sumOld.stepNs  += b.stepNs; sumOld.rulesNs  += b.rulesNs; sumOld.ops += b.ops;
+    }
+
+    printf("%-6s | %10.1f %10.1f | %10.1f %10.1f %10.1f\n", "total",
+           (double)sumFlat.stepNs / sumFlat.ops, (double)sumOld.stepNs / sumOld.ops,
+           (double)sumFlat.rulesNs / sumFlat.ops, (double)sumFlat.fullNs / sumFlat.ops,
+           (double)sumOld.rulesNs / sumOld.ops);
+    printf("sizeof(Grid) = %zu octets (arène plate)\n", sizeof(Grid));
+
+    // Empreinte : recalcul complet (la grille la tient à jour en O(1))
+    printf("hash : recalcul complet %.1f ns\n", (double)sumFlat.hashNs / sumFlat.ops);
+
+    // Journal d’annulation
+    int64_t undoNs = 0;
+    long undone = 0;
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        UndoCheck u = run_undo(flat, lv);
+        undoNs += u.undoNs;
+        undone += u.undone;
+    }
+    printf("undo : %d coups x %d niveaux, %ld annulés, %.1f ns/undo\n",
+           UNDO_MOVES, levels_count(), undone, undone ? (double)undoNs / undone : 0.0);
+
+    // Nombreux YOU : résolution groupée contre référence un YOU à la fois
+    run_stress(2000);
+
+    // Objets MOVE : phase groupée
+    run_move(5000);
+
+    // Interactions et effets WIN / KILL : incrémental contre passe complète
+    static Grid fullPass;
+    EffectCheck levelsCheck, soupCheck;
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        load_level(lv, flat);
+        fullPass = flat;
+        run_lockstep(flat, fullPass, 4242u + (uint32_t)lv, 5000, levelsCheck);
+    }
+    for (uint32_t seed = 1; seed <= 32; ++seed) {
+        build_soup(flat, seed);
+        fullPass = flat;
+        run_lockstep(flat, fullPass, seed, 3000, soupCheck);
+    }
+    printf("effects : niveaux, %ld coups, %ld objets détruits, incrémental %.1f ns, complet %.1f ns\n",
+           levelsCheck.steps, levelsCheck.removed, (double)levelsCheck.incNs / levelsCheck.steps,
+           (double)levelsCheck.fullNs / levelsCheck.steps);
+    printf("effects : soupes SINK/HOT/MELT/OPEN/SHUT/FLOAT, %ld coups, %ld objets détruits,"
+           " incrémental %.1f ns, complet %.1f ns\n",
+           soupCheck.steps, soupCheck.removed, (double)soupCheck.incNs / soupCheck.steps,
+           (double)soupCheck.fullNs / soupCheck.steps);
+
+    // Pack de niveaux : load_level() depuis le pack intégré
+    const int N = 2000;
+    auto t0 = Clock::now();
+    for (int i = 0; i < N; ++i) load_level(i % levels_count(), flat);
+    printf("levelpack : %d niveaux, %u octets, load_level %.1f ns\n",
+           levels_count(), (unsigned)LEVEL_PACK_BUILTIN_SIZE, (double)ns_since(t0) / N);
+
+    // Coût par frame (40 FPS) de la recherche caméra du premier YOU
+    double scan = (double)sumFlat.youScanNs / sumFlat.ops;
+    double idx  = (double)sumFlat.youIdxNs  / sumFlat.ops;
+    printf("find_you / frame : scan %.1f ns, index %.1f ns"
+           " -> %.1f us/s économisées à 40 FPS\n",
+           scan, idx, (scan - idx) * 40.0 / 1000.0);
+
+    return 0;
+}
@@ -0,0 +1,627 @@
+/*
+===============================================================================
+  fixtures.h — Outils communs aux programmes hôtes de mesure et de test
+-------------------------------------------------------------------------------
+  Rôle :
+    - Ancien moteur de référence (namespace legacy) : stockage en
+      vector<Object> par case et analyse complète des règles à chaque coup,
+      copie fidèle du moteur d’origine (à l’ordre de résolution près).
+    - Niveaux construits pour les mesures et les tests : stress (160 YOU),
+      soupes d’interactions, rochers MOVE.
+    - Comparaisons d’états (grilles, tables de propriétés) et passes
+      différentielles (annulation, effets incrémentaux contre passe
+      complète), qui mesurent et vérifient à la fois.
+
+  Notes :
+    - Partagé par bench_grid (mesures) et test_engine (vérifications,
+      ctest) : fonctions inline, aucune n’est obligatoirement utilisée.
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+#include "core/grid.h"
+#include "core/rules.h"
+#include "core/movement.h"
+#include "core/undo.h"
+#include "core/replay.h"
+#include "game/levels.h"
+#include "game/levelpack.h"
+
+using namespace baba;
+
+// ============================================================================
+//  Ancien stockage (référence) : un vector<Object> par case
+//  Copie fidèle du moteur d’origine, pour comparaison uniquement, à l’ordre
+//  de résolution près : une entrée par case YOU, de la plus avancée à la plus
+//  en retrait dans le sens du coup (comme step() depuis la résolution groupée).
+//  Interactions (SINK, HOT / MELT, OPEN / SHUT, couches FLOAT) : parcours
+//  complet de la carte après chaque coup, référence de la passe incrémentale.
+// ============================================================================
+namespace legacy {
+
+struct Properties {
+    bool isYou = false, isPush = false, isStop = false, isWin = false;
+    bool isSink = false, isKill = false, isHot = false, isMelt = false;
+    bool isMove = false, isOpen = false, isShut = false, isFloat = false;
+};
+using PropertyTable = std::array<Properties, (int)ObjectType::Count>;
+
+struct Cell { std::vector<Object> objects; };
+
+struct Grid {
+    int width, height;
+    std::vector<Cell> cells;
+    int playMinX = 0, playMinY = 0, playMaxX = 0, playMaxY = 0;
+
+    Grid(int w = MAP_WIDTH, int h = MAP_HEIGHT) : width(w), height(h), cells(w * h) {}
+    Cell&       cell(int x, int y)       { return cells[y * width + x]; }
+    const Cell& cell(int x, int y) const { return cells[y * width + x]; }
+    bool in_bounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+    bool in_play_area(int x, int y) const {
+        return x >= playMinX && x <= playMaxX && y >= playMinY && y <= playMaxY;
+    }
+};
+
+// Contenu de départ lu dans le pack par le chargeur actuel, puis recopié
+// case par case dans l’ancien stockage
+inline void load_level(int index, Grid& g)
+{
+    static baba::Grid packed;
+    baba::load_level(index, packed);
+
+    g = Grid(MAP_WIDTH, MAP_HEIGHT);
+    g.playMinX = packed.playMinX;
+    g.playMinY = packed.playMinY;
+    g.playMaxX = packed.playMaxX;
+    g.playMaxY = packed.playMaxY;
+    for (int i = 0; i < packed.cell_count(); ++i)
+        for (const Object& o : packed.cell_at(i).objects)
+            g.cells[i].objects.push_back(o);
+}
+
+inline bool is_subject_word(ObjectType t) { return t >= ObjectType::Text_Baba && t <= ObjectType::Text_Empty; }
+inline bool is_status_word(ObjectType t)  { return t >= ObjectType::Text_Push && t <= ObjectType::Text_Float; }
+
+inline void rules_parse(const Grid& g, PropertyTable& table)
+{
+    for (size_t i = 0; i < table.size(); i++) {
+        table[i] = Properties{};
+        if ((ObjectType)i >= ObjectType::Text_Baba) table[i].isPush = true;
+    }
+    auto process = [&](ObjectType a, ObjectType b, ObjectType c) {
+        if (b != ObjectType::Text_Is || !is_subject_word(a) || !is_status_word(c)) return;
+        ObjectType subj = (a == ObjectType::Text_Empty)
+                        ? ObjectType::Empty
+                        : (ObjectType)((int)a - (int)ObjectType::Text_Baba + (int)ObjectType::Baba);
+        Properties& p = table[(size_t)subj];
+        switch (c) {
+            case ObjectType::Text_You:  p.isYou = true; break;
+            case ObjectType::Text_Push: p.isPush = true; break;
+            case ObjectType::Text_Stop: p.isStop = true; break;
+            case ObjectType::Text_Win:  p.isWin = true; break;
+            case ObjectType::Text_Sink: p.isSink = true; break;
+            case ObjectType::Text_Kill: p.isKill = true; break;
+            case ObjectType::Text_Hot:  p.isHot = true; break;
+            case ObjectType::Text_Melt: p.isMelt = true; break;
+            case ObjectType::Text_Move: p.isMove = true; break;
+            case ObjectType::Text_Open: p.isOpen = true; break;
+            case ObjectType::Text_Shut: p.isShut = true; break;
+            case ObjectType::Text_Float:p.isFloat = true; break;
+            default: break;
+        }
+    };
+    // Mot d’une case (les objets poussés sur un mot ou sous lui sont ignorés)
+    std::vector<ObjectType> words(g.cells.size(), ObjectType::Empty);
+    for (size_t i = 0; i < g.cells.size(); i++)
+        for (auto& obj : g.cells[i].objects)
+            if (obj.type >= ObjectType::Text_Baba) { words[i] = obj.type; break; }
+    auto word = [&](int x, int y) { return words[y * g.width + x]; };
+    for (int y = 0; y < g.height; y++)
+        for (int x = 0; x < g.width - 2; x++) {
+            ObjectType w0 = word(x, y), w1 = word(x + 1, y), w2 = word(x + 2, y);
+            if (w0 == ObjectType::Empty || w1 == ObjectType::Empty || w2 == ObjectType::Empty) continue;
+            process(w0, w1, w2);
+        }
+    for (int y = 0; y < g.height - 2; y++)
+        for (int x = 0; x < g.width; x++) {
+            ObjectType w0 = word(x, y), w1 = word(x, y + 1), w2 = word(x, y + 2);
+            if (w0 == ObjectType::Empty || w1 == ObjectType::Empty || w2 == ObjectType::Empty) continue;
+            process(w0, w1, w2);
+        }
+}
+
+inline bool try_push_chain(Grid& grid, const PropertyTable& props, int startX, int startY, int dx, int dy)
+{
+    int cx = startX, cy = startY;
+    std::vector<std::pair<int,int>> chain;
+    while (grid.in_bounds(cx, cy) && grid.in_play_area(cx, cy)) {
+        Cell& c = grid.cell(cx, cy);
+        if (c.objects.empty()) break;
+        bool anyPush = false;
+        for (auto& obj : c.objects) {
+            const Properties& pr = props[(int)obj.type];
+            if (pr.isStop && !pr.isPush) return false;
+            anyPush |= pr.isPush;
+        }
+        if (!anyPush) break;   // objets PUSH et non PUSH : seuls les premiers avancent
+        chain.emplace_back(cx, cy);
+        cx += dx; cy += dy;
+    }
+    if (chain.empty()) {
+        for (auto& obj : grid.cell(startX, startY).objects)
+            if (props[(int)obj.type].isStop) return false;
+        return true;
+    }
+    if (!grid.in_bounds(cx, cy) || !grid.in_play_area(cx, cy)) return false;
+    for (auto& obj : grid.cell(cx, cy).objects)
+        if (props[(int)obj.type].isStop) return false;
+    for (int i = (int)chain.size() - 1; i >= 0; --i) {
+        Cell& from = grid.cell(chain[i].first, chain[i].second);
+        Cell& to   = grid.cell(chain[i].first + dx, chain[i].second + dy);
+        std::vector<Object> moving;
+        for (auto& obj : from.objects) if (props[(int)obj.type].isPush) moving.push_back(obj);
+        from.objects.erase(std::remove_if(from.objects.begin(), from.objects.end(),
+                           [&](const Object& o) { return props[(int)o.type].isPush; }),
+                           from.objects.end());
+        for (auto& mo : moving) to.objects.push_back(mo);
+    }
+    return true;
+}
+
+inline MoveResult step(Grid& grid, const PropertyTable& props, int dx, int dy)
+{
+    MoveResult result;
+    struct YouPos { int x, y; };
+    std::vector<YouPos> yous;
+    yous.reserve(grid.width * grid.height);
+    for (int y = 0; y < grid.height; ++y)
+        for (int x = 0; x < grid.width; ++x)
+            for (const auto& obj : grid.cell(x, y).objects)
+                if (props[(int)obj.type].isYou) { yous.push_back({x, y}); break; }
+    if (dx > 0 || dy > 0) std::reverse(yous.begin(), yous.end());
+
+    for (const auto& yp : yous) {
+        int nx = yp.x + dx, ny = yp.y + dy;
+        if (!grid.in_bounds(nx, ny) || !grid.in_play_area(nx, ny)) continue;
+        bool blocked = false;
+        for (auto& obj : grid.cell(nx, ny).objects)
+            if (props[(int)obj.type].isStop && !props[(int)obj.type].isPush) { blocked = true; break; }
+        if (blocked) continue;
+        if (!try_push_chain(grid, props, nx, ny, dx, dy)) continue;
+        Cell& src = grid.cell(yp.x, yp.y);
+        Cell& dst = grid.cell(nx, ny);
+        for (auto it = src.objects.begin(); it != src.objects.end(); ) {
+            if (props[(int)it->type].isYou) { dst.objects.push_back(*it); it = src.objects.erase(it); }
+            else ++it;
+        }
+    }
+    for (auto& cell : grid.cells) {
+        for (int layer = 0; layer < 2; ++layer) {
+            auto inLayer = [&](const Object& o) { return props[(int)o.type].isFloat == (layer == 1); };
+            int n = 0;
+            bool hasSink = false, hasHot = false, hasOpen = false, hasShut = false;
+            for (auto& obj : cell.objects) {
+                if (!inLayer(obj)) continue;
+                const Properties& pr = props[(int)obj.type];
+                n++; hasSink |= pr.isSink; hasHot |= pr.isHot; hasOpen |= pr.isOpen; hasShut |= pr.isShut;
+            }
+            auto doomed = [&](const Object& o) {
+                const Properties& pr = props[(int)o.type];
+                if (!inLayer(o)) return false;
+                if (hasSink && n > 1) return true;
+                if (hasHot && pr.isMelt) return true;
+                return hasOpen && hasShut && (pr.isOpen || pr.isShut);
+            };
+            for (auto it = cell.objects.begin(); it != cell.objects.end(); ) {
+                if (!doomed(*it)) { ++it; continue; }
+                if (props[(int)it->type].isYou) result.hasDied = true;
+                it = cell.objects.erase(it);
+            }
+        }
+        for (int layer = 0; layer < 2; ++layer) {
+            bool hasYou = false, hasWin = false, hasKill = false;
+            for (auto& obj : cell.objects) {
+                const Properties& pr = props[(int)obj.type];
+                if (pr.isFloat != (layer == 1)) continue;
+                hasYou |= pr.isYou; hasWin |= pr.isWin; hasKill |= pr.isKill;
+            }
+            if (hasYou && hasWin) result.hasWon = true;
+            if (hasYou && hasKill) result.hasDied = true;
+        }
+    }
+    return result;
+}
+
+} // namespace legacy
+
+
+
+// ============================================================================
+//  Outils de mesure et de comparaison
+// ============================================================================
+using Clock = std::chrono::steady_clock;
+
+inline int64_t ns_since(Clock::time_point t0)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+}
+
+// Générateur pseudo-aléatoire déterministe (même suite pour les deux moteurs)
+struct Lcg {
+    uint32_t s;
+    uint32_t next() { s = s * 1664525u + 1013904223u; return s >> 16; }
+};
+
+constexpr int DIRS[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+
+// Ancienne recherche du premier YOU (game.cpp) : parcours complet de la carte
+inline int find_you_scan(const Grid& g, const PropertyTable& props)
+{
+    const TypeMask you = props.types_with(PROP_YOU);
+    for (int i = 0; i < g.cell_count(); ++i)
+        if (g.cellTypes[i] & you) return i;
+    return -1;
+}
+
+// Compare le contenu des deux grilles (sanity check)
+inline bool same_state(const Grid& a, const legacy::Grid& b)
+{
+    for (int y = 0; y < MAP_HEIGHT; ++y)
+        for (int x = 0; x < MAP_WIDTH; ++x) {
+            auto sa = a.cell(x, y).objects;
+            auto& sb = b.cell(x, y).objects;
+            if (sa.size() != (int)sb.size()) return false;
+            for (int i = 0; i < sa.size(); ++i)
+                if (sa[i].type != sb[i].type) return false;
+        }
+    return true;
+}
+
+inline bool same_cond(const CondRule& a, const CondRule& b)
+{
+    return a.subjects == b.subjects && a.onAll == b.onAll && a.onNone == b.onNone &&
+           a.prop == b.prop && a.negated == b.negated;
+}
+
+// Les règles conditionnelles sont comparées sans tenir compte de leur ordre
+inline bool same_props(const PropertyTable& a, const PropertyTable& b)
+{
+    if (!(a.flags == b.flags && a.types == b.types && a.denied == b.denied &&
+          a.becomes == b.becomes && a.transforms == b.transforms &&
+          a.holds == b.holds && a.condCount == b.condCount &&
+          a.condOverflow == b.condOverflow))
+        return false;
+    for (int i = 0; i < a.condCount; ++i) {
+        int na = 0, nb = 0;
+        for (int k = 0; k < a.condCount; ++k) {
+            na += same_cond(a.cond[i], a.cond[k]);
+            nb += same_cond(a.cond[i], b.cond[k]);
+        }
+        if (na != nb) return false;
+    }
+    return true;
+}
+
+// Compare deux grilles de l’arène : piles (ordre compris), masques et index
+inline bool same_grid(const Grid& a, const Grid& b)
+{
+    if (a.width != b.width || a.height != b.height) return false;
+    if (a.cellTypes != b.cellTypes) return false;
+    for (int t = 0; t < (int)ObjectType::Count; ++t)
+        if (a.typeCells[t].bits != b.typeCells[t].bits) return false;
+    for (int i = 0; i < a.cell_count(); ++i) {
+        auto sa = a.cell_at(i).objects;
+        auto sb = b.cell_at(i).objects;
+        if (sa.size() != sb.size()) return false;
+        for (int k = 0; k < sa.size(); ++k)
+            if (sa[k].type != sb[k].type || sa[k].dir != sb[k].dir) return false;
+    }
+    return true;
+}
+
+// Journal d’annulation : coups aléatoires, tout annuler, tout rejouer
+//  - Chaque entrée essaie les quatre directions (la première au hasard) et
+//    garde le premier coup qui change la grille sans tuer ni perdre YOU ;
+//    un coup refusé est annulé. Sans coup possible, on recule d’un coup.
+//    Sans cela, YOU meurt ou se bloque tôt et le journal reste presque vide.
+//  - undone : coups effectivement annulés (au moins UNDO_MIN_UNDONE).
+constexpr int UNDO_MOVES      = 10000;
+constexpr int UNDO_MIN_UNDONE = UNDO_MOVES / 2;
+
+struct UndoCheck {
+    bool    ok      = true;
+    int64_t undoNs  = 0;
+    long    undone  = 0;
+};
+
+inline UndoCheck run_undo(Grid& g, int level)
+{
+    UndoCheck c;
+    static std::vector<UndoEntry> buffer(UNDO_MOVES * 64);
+    static Grid initial, final;
+    static RuleSet rules;
+    UndoJournal journal(buffer.data(), (int)buffer.size());
+    PropertyTable props, props0, props1;
+    Lcg rng{ 777u + (uint32_t)level };
+
+    load_level(level, initial);
+    load_level(level, g);
+    g.journal = &journal;
+    rules_update(g, rules, props);
+    props0 = props;
+
+    auto back = [&]() {
+        if (!journal.undo(g)) return false;
+        rules_update(g, rules, props);
+        return true;
+    };
+
+    // Pas de rechargement sur victoire/mort : l’historique doit tout couvrir
+    for (int i = 0; i < UNDO_MOVES; ++i) {
+        const int first = (int)(rng.next() & 3);
+        bool moved = false;
+        for (int k = 0; k < 4 && !moved; ++k) {
+            const int* d    = DIRS[(first + k) & 3];
+            const int  used = journal.used();
+            const bool died = step(g, props, d[0], d[1]).hasDied;
+            rules_update(g, rules, props);
+            if (journal.used() == used) continue;   // rien n’a bougé
+            if (died || g.first_cell_with(props.types_any(PROP_YOU)) < 0) back();
+            else moved = true;
+        }
+        if (!moved) back();
+    }
+    // Un coup refusé ou un recul laisse un historique redo : l’état final
+    // est le bout de l’historique
+    while (journal.redo(g)) rules_update(g, rules, props);
+    final  = g;
+    props1 = props;
+
+    auto t0 = Clock::now();
+    while (journal.undo(g)) {
+        rules_update(g, rules, props);
+        c.undone++;
+    }
+    c.undoNs = ns_since(t0);
+    c.ok &= same_grid(g, initial) && same_props(props, props0);
+    c.ok &= g.hash == initial.hash && g.hash == g.compute_hash();
+
+    while (journal.redo(g)) rules_update(g, rules, props);
+    c.ok &= same_grid(g, final) && same_props(props, props1);
+    c.ok &= g.state_hash() == final.state_hash();
+
+    g.journal = nullptr;
+    return c;
+}
+
+// ============================================================================
+//  Interactions et effets : passe incrémentale contre passe complète
+//  - Deux grilles jouées en parallèle, sans rechargement sur victoire/mort
+//    (les superpositions persistent d’un coup à l’autre), avec undo/redo et
+//    transformations, comme input_apply() : inc en incrémental, full avec
+//    toutes les cases notées avant chaque coup (passe complète).
+//  - Après chaque step(), grilles, résultats et ensembles Grid::effects
+//    (win, death) doivent être identiques, et ces derniers égaux à un
+//    parcours de toutes les cases YOU.
+//  - Sur les niveaux livrés (SINK) et sur des soupes aléatoires de phrases
+//    SINK, HOT / MELT, OPEN / SHUT, FLOAT, MOVE et HAS.
+// ============================================================================
+inline void full_effects(const Grid& g, const PropertyTable& props, CellSet& win, CellSet& death)
+{
+    win.clear();
+    death.clear();
+    g.cells_with(props.types_any(PROP_YOU)).for_each([&](int i) {
+        const TypeMask t   = g.cellTypes[i];
+        const TypeMask you = t & props.types_at(PROP_YOU, t);
+        if (!you) return;
+        const TypeMask up = t & props.types_at(PROP_FLOAT, t);
+        auto meet = [&](TypeMask other) {
+            return ((you & up) && (other & up)) || ((you & ~up) && (other & t & ~up));
+        };
+        if (meet(t & props.types_at(PROP_WIN, t)))  win.set(i);
+        if (meet(t & props.types_at(PROP_KILL, t))) death.set(i);
+    });
+}
+
+inline bool effects_match(const Grid& g, const PropertyTable& props, const MoveResult& r)
+{
+    CellSet win, death;
+    full_effects(g, props, win, death);
+    return win.bits == g.effects.win.bits && death.bits == g.effects.death.bits &&
+           r.hasWon == (win.first() >= 0) && (death.first() < 0 || r.hasDied);
+}
+
+struct EffectCheck {
+    bool    ok      = true;
+    long    steps   = 0;
+    long    removed = 0;   // objets détruits par les interactions
+    int64_t incNs   = 0;
+    int64_t fullNs  = 0;
+};
+
+inline int object_count(const Grid& g)
+{
+    int n = 0;
+    for (int i = 0; i < g.cell_count(); ++i) n += g.slots[i].count;
+    return n;
+}
+
+// inc et full contiennent le même état initial, sans journal
+inline void run_lockstep(Grid& inc, Grid& full, uint32_t seed, int inputs, EffectCheck& c)
+{
+    static std::vector<UndoEntry> bufInc(4096), bufFull(4096);
+    static RuleSet rulesInc, rulesFull;
+    UndoJournal jInc(bufInc.data(), (int)bufInc.size());
+    UndoJournal jFull(bufFull.data(), (int)bufFull.size());
+    PropertyTable pInc, pFull;
+    Lcg rng{ seed };
+
+    inc.journal  = &jInc;
+    full.journal = &jFull;
+    rulesInc.count = rulesFull.count = 0;
+    rules_update(inc, rulesInc, pInc);
+    rules_update(full, rulesFull, pFull);
+
+    for (int i = 0; i < inputs; ++i) {
+        const uint32_t k = rng.next() % 10;
+        if (k < 8) {
+            const int* d = DIRS[k & 3];
+            const int before = object_count(inc);
+
+            jInc.begin_move();
+            auto t0 = Clock::now();
+            MoveResult a = step(inc, pInc, d[0], d[1]);
+            c.incNs += ns_since(t0);
+
+            jFull.begin_move();
+            for (int n = 0; n < full.cell_count(); ++n) full.effects.dirty.set(n);
+            t0 = Clock::now();
+            MoveResult b = step(full, pFull, d[0], d[1]);
+            c.fullNs += ns_since(t0);
+
+            c.ok &= a.hasWon == b.hasWon && a.hasDied == b.hasDied &&
+                    inc.hash == full.hash && same_grid(inc, full) &&
+                    inc.effects.win.bits == full.effects.win.bits &&
+                    inc.effects.death.bits == full.effects.death.bits &&
+                    effects_match(inc, pInc, a);
+            c.steps++;
+            c.removed += std::max(0, before - object_count(inc));
+
+            rules_update(inc, rulesInc, pInc);
+            if (apply_transforms(inc, pInc)) rules_update(inc, rulesInc, pInc);
+            jInc.end_move();
+            rules_update(full, rulesFull, pFull);
+            if (apply_transforms(full, pFull)) rules_update(full, rulesFull, pFull);
+            jFull.end_move();
+        } else {
+            if (k == 8) { jInc.undo(inc); jFull.undo(full); }
+            else        { jInc.redo(inc); jFull.redo(full); }
+            rules_update(inc, rulesInc, pInc);
+            rules_update(full, rulesFull, pFull);
+        }
+    }
+    inc.journal  = nullptr;
+    full.journal = nullptr;
+}
+
+// Soupe d’interactions : 12 phrases poussables et 240 objets au hasard sur
+// toute la carte (aucun niveau livré n’utilise HOT, MELT, OPEN, SHUT ni FLOAT)
+inline void build_soup(Grid& g, uint32_t seed)
+{
+    using T = ObjectType;
+    static const T pool[][3] = {
+        { T::Text_Rock, T::Text_Is,  T::Text_Push  }, { T::Text_Lava, T::Text_Is,  T::Text_Hot   },
+        { T::Text_Rock, T::Text_Is,  T::Text_Melt  }, { T::Text_Baba, T::Text_Is,  T::Text_Melt  },
+        { T::Text_Flag, T::Text_Is,  T::Text_Open  }, { T::Text_Wall, T::Text_Is,  T::Text_Shut  },
+        { T::Text_Wall, T::Text_Is,  T::Text_Open  }, { T::Text_Goop, T::Text_Is,  T::Text_Sink  },
+        { T::Text_Rock, T::Text_Is,  T::Text_Sink  }, { T::Text_Love, T::Text_Is,  T::Text_Float },
+        { T::Text_Baba, T::Text_Is,  T::Text_Float }, { T::Text_Love, T::Text_Is,  T::Text_Move  },
+        { T::Text_Rock, T::Text_Is,  T::Text_Move  }, { T::Text_Goop, T::Text_Has, T::Text_Love  },
+        { T::Text_Flag, T::Text_Is,  T::Text_Win   }, { T::Text_Lava, T::Text_Is,  T::Text_Kill  },
+        { T::Text_Wall, T::Text_Is,  T::Text_Stop  }, { T::Text_Lava, T::Text_Is,  T::Text_Sink  },
+    };
+    constexpr int POOL = sizeof(pool) / sizeof(pool[0]);
+    Lcg rng{ seed };
+
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMinX = 0;
+    g.playMinY = 0;
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+
+    for (int s = 0; s < 12; ++s) {
+        const T* words = s == 0 ? nullptr : pool[rng.next() % POOL];
+        static const T you[3] = { T::Text_Baba, T::Text_Is, T::Text_You };
+        for (int k = 0; k < 3; ++k)
+            g.cell((s % 4) * 8 + 1 + k, (s / 4) * 8 + 1).objects.push_back({ words ? words[k] : you[k] });
+    }
+    for (int n = 0; n < 240; ++n) {
+        const int x = rng.next() % MAP_WIDTH;
+        const int y = rng.next() % MAP_HEIGHT;
+        if (y % 8 == 1) continue;   // lignes des phrases
+        const T t = (T)((int)T::Baba + rng.next() % ((int)T::Love - (int)T::Baba + 1));
+        g.cell(x, y).objects.push_back({ t, (uint8_t)(rng.next() & 3) });
+    }
+}
+
+// ============================================================================
+//  Niveau de stress : 160 YOU (BABA IS YOU, BABA IS PUSH) en rangées
+//  serrées, sur toute la carte
+//  - Lignes paires : babas puis rochers collés à un mur (chaîne bloquée
+//    vers la droite) ; lignes impaires : libres.
+//  - Colonnes 2 à 5 : un mur sous la dernière rangée (chaînes verticales
+//    de 20 babas bloquées vers le bas).
+// ============================================================================
+template <class G>
+inline void build_stress(G& g)
+{
+    g.playMinX = 0;
+    g.playMinY = 0;
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+    auto put = [&](int x, int y, ObjectType t) { g.cell(x, y).objects.push_back({t}); };
+
+    const ObjectType rules[4][3] = {
+        { ObjectType::Text_Baba, ObjectType::Text_Is, ObjectType::Text_You  },
+        { ObjectType::Text_Baba, ObjectType::Text_Is, ObjectType::Text_Push },
+        { ObjectType::Text_Rock, ObjectType::Text_Is, ObjectType::Text_Push },
+        { ObjectType::Text_Wall, ObjectType::Text_Is, ObjectType::Text_Stop },
+    };
+    for (int r = 0; r < 4; ++r)
+        for (int k = 0; k < 3; ++k) put(r * 8 + k, 0, rules[r][k]);
+
+    for (int y = 2; y < 22; ++y) {
+        for (int x = 2; x < 10; ++x) put(x, y, ObjectType::Baba);
+        if (y % 2 == 0) {
+            for (int x = 10; x < 14; ++x) put(x, y, ObjectType::Rock);
+            put(14, y, ObjectType::Wall);
+        }
+    }
+    for (int x = 2; x < 6; ++x) put(x, 22, ObjectType::Wall);
+}
+
+// Mots (ou objets) posés de gauche à droite à partir de (x, y) ; Empty = case sautée
+inline void place_words(Grid& g, int x, int y, std::initializer_list<ObjectType> words)
+{
+    for (ObjectType t : words) {
+        if (t != ObjectType::Empty) g.cell(x, y).objects.push_back({t});
+        x++;
+    }
+}
+
+// ============================================================================
+//  Phase MOVE : 60 rochers MOVE (4 orientations) sur toute la carte,
+//  drapeaux PUSH sur leur passage, un BABA YOU
+// ============================================================================
+inline void build_movers(Grid& g)
+{
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+    const ObjectType words[9] = {
+        ObjectType::Text_Baba, ObjectType::Text_Is, ObjectType::Text_You,
+        ObjectType::Text_Rock, ObjectType::Text_Is, ObjectType::Text_Move,
+        ObjectType::Text_Flag, ObjectType::Text_Is, ObjectType::Text_Push,
+    };
+    for (int k = 0; k < 9; ++k) g.cell((k / 3) * 8 + k % 3, 0).objects.push_back({words[k]});
+    for (int y = 2; y < 22; ++y)
+        for (int k = 0; k < 3; ++k) {
+            const int x = 4 + k * 9 + y % 5;
+            g.cell(x, y).objects.push_back({ObjectType::Rock, (uint8_t)((y + k) & 3)});
+            if (y % 3 == 0) g.cell(x + 2, y).objects.push_back({ObjectType::Flag});
+        }
+    g.cell(1, 23).objects.push_back({ObjectType::Baba});
+}
@@ -0,0 +1,381 @@
+/*
+===============================================================================
+  levelc.cpp — Compilateur hôte de packs de niveaux (cartes ASCII → .pak)
+-------------------------------------------------------------------------------
+  Rôle :
+    - Lire des cartes ASCII éditables à la main (une par niveau) et les
+      assembler en un pack au format levelpack.h.
+    - Refuser les cartes invalides : code inconnu, lignes de longueurs
+      différentes, dimensions au-delà de MAP_WIDTH × MAP_HEIGHT, case trop
+      chargée.
+    - Donner, par niveau, la taille du flux et le temps de décodage
+      (levelpack_decode, le chemin de load_level()).
+    - Écrire le pack (fichier pour la carte SD) et / ou régénérer
+      game/levels_data.cpp (pack intégré en flash).
+    - Extraire les cartes d’un pack existant (--dump), pour éditer un pack
+      dont on n’a plus les sources.
+
+  Format des cartes :
+    - Une ligne de texte par ligne du niveau, cases séparées par des
+      espaces ; les lignes vides et celles commençant par # sont ignorées.
+    - Une case : un code de game/defines.h (WALL, ROCK, W_BABA, W_IS…),
+      . ou EMPTY pour une case vide, A+B pour plusieurs objets dans la même
+      case (du bas vers le haut).
+    - Tous les mots du registre (vocabulary.h) sont acceptés, même sans
+      macro dans defines.h : Text_Hot s’écrit W_HOT.
+    - Le niveau est centré dans la carte du moteur (MAP_WIDTH × MAP_HEIGHT).
+
+  Utilisation :
+    levelc [-o levels.pak] [--c game/levels_data.cpp] carte.txt…
+    levelc --dump DOSSIER [levels.pak]     (sans pack : pack intégré)
+
+  Compilation : voir host/CMakeLists.txt (cible levelc).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "core/grid.h"
+#include "core/vocabulary.h"
+#include "game/levels.h"
+#include "game/levelpack.h"
+
+using namespace baba;
+
+// Fins de ligne des fichiers écrits : celles du dépôt
+static const char* NL = "\r\n";
+
+// -----------------------------------------------------------------------------
+//  Codes des cartes : ceux de defines.h, générés depuis le registre
+//  (Baba → BABA, Text_Baba → W_BABA)
+// -----------------------------------------------------------------------------
+static std::string code_name(const char* type)
+{
+    std::string s;
+    if (!strncmp(type, "Text_", 5)) { s = "W_"; type += 5; }
+    for (; *type; ++type) s += (char)toupper((unsigned char)*type);
+    return s;
+}
+
+static const std::vector<std::string>& code_names()
+{
+    static std::vector<std::string> names;
+    if (names.empty()) {
+#define BABA_CODE_NAME(type, kind, object, prop, tile) names.push_back(code_name(#type));
+        BABA_OBJECT_TYPES(BABA_CODE_NAME)
+#undef BABA_CODE_NAME
+    }
+    return names;
+}
+
+// ObjectType d’un code, ou -1
+static int parse_code(const std::string& code)
+{
+    if (code == ".") return (int)ObjectType::Empty;
+    const auto& names = code_names();
+    for (size_t t = 0; t < names.size(); ++t)
+        if (names[t] == code) return (int)t;
+    return -1;
+}
+
+// -----------------------------------------------------------------------------
+//  Lecture d’une carte dans une grille (niveau centré)
+// -----------------------------------------------------------------------------
+static bool read_map(const char* path, Grid& g, std::string& err)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) { err = "ouverture impossible"; return false; }
+
+    std::vector<std::vector<std::vector<ObjectType>>> rows;
+    char line[1024];
+    int lineNo = 0;
+    bool ok = true;
+
+    while (ok && fgets(line, sizeof(line), f)) {
+        lineNo++;
+        const char* p = line;
+        while (*p == ' ' || *p == '\t') ++p;
+        if (*p == '#' || *p == '\r' || *p == '\n' || *p == 0) continue;
+
+        std::vector<std::vector<ObjectType>> row;
+        while (*p && *p != '\r' && *p != '\n') {
+            std::string token;
+            while (*p && !isspace((unsigned char)*p)) token += *p++;
+            while (*p == ' ' || *p == '\t') ++p;
+
+            // A+B+… : pile d’objets
+            std::vector<ObjectType> stack;
+            size_t start = 0;
+            while (ok) {
+                size_t plus = token.find('+', start);
+                std::string code = token.substr(start, plus == std::string::npos ? plus : plus - start);
+                int t = parse_code(code);
+                if (t < 0) {
+                    err = "ligne " + std::to_string(lineNo) + " : code inconnu « " + code + " »";
+                    ok = false;
+                } else if (t != (int)ObjectType::Empty) {
+                    stack.push_back((ObjectType)t);
+                }
+                if (plus == std::string::npos) break;
+                start = plus + 1;
+            }
+            row.push_back(stack);
+        }
+
+        if (ok && !rows.empty() && row.size() != rows[0].size()) {
+            err = "ligne " + std::to_string(lineNo) + " : " + std::to_string(row.size()) +
+                  " cases au lieu de " + std::to_string(rows[0].size());
+            ok = false;
+        }
+        rows.push_back(row);
+    }
+    fclose(f);
+    if (!ok) return false;
+
+    const int h = (int)rows.size();
+    const int w = h ? (int)rows[0].size() : 0;
+    if (w == 0 || h == 0) { err = "carte vide"; return false; }
+    if (w > MAP_WIDTH || h > MAP_HEIGHT) {
+        err = "niveau " + std::to_string(w) + "×" + std::to_string(h) + " plus grand que la carte " +
+              std::to_string(MAP_WIDTH) + "×" + std::to_string(MAP_HEIGHT);
+        return false;
+    }
+
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMinX = (MAP_WIDTH  - w) / 2;
+    g.playMinY = (MAP_HEIGHT - h) / 2;
+    g.playMaxX = g.playMinX + w - 1;
+    g.playMaxY = g.playMinY + h - 1;
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            for (ObjectType t : rows[y][x])
+                if (!g.cell(g.playMinX + x, g.playMinY + y).objects.push_back(Object{ t })) {
+                    err = "case (" + std::to_string(x + 1) + ", " + std::to_string(y + 1) +
+                          ") : trop d’objets";
+                    return false;
+                }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+//  Écriture d’une carte (--dump)
+// -----------------------------------------------------------------------------
+static bool write_map(const char* path, const Grid& g, int level)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    const auto& names = code_names();
+    fprintf(f, "# Niveau %d%s", level, NL);
+    for (int y = g.playMinY; y <= g.playMaxY; ++y) {
+        std::string line;
+        for (int x = g.playMinX; x <= g.playMaxX; ++x) {
+            std::string cell;
+            for (const Object& o : g.cell(x, y).objects) {
+                if (!cell.empty()) cell += '+';
+                cell += names[(int)o.type];
+            }
+            if (cell.empty()) cell = ".";
+            if (x < g.playMaxX) cell.resize(std::max<size_t>(cell.size() + 1, 7), ' ');
+            line += cell;
+        }
+        fprintf(f, "%s%s", line.c_str(), NL);
+    }
+    return fclose(f) == 0;
+}
+
+static int dump(const char* dir, const char* packPath)
+{
+    if (packPath && !levels_open(packPath)) {
+        fprintf(stderr, "%s : pack illisible\n", packPath);
+        return 1;
+    }
+    static Grid g;
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/level%02d.txt", dir, lv + 1);
+        if (!load_level(lv, g) || !write_map(path, g, lv + 1)) {
+            fprintf(stderr, "%s : écriture impossible\n", path);
+            return 1;
+        }
+        printf("%s\n", path);
+    }
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+//  Écriture du pack intégré (game/levels_data.cpp)
+// -----------------------------------------------------------------------------
+static const char* base_name(const char* path)
+{
+    const char* s = strrchr(path, '/');
+    return s ? s + 1 : path;
+}
+
+static void write_bytes(FILE* f, const uint8_t* p, uint32_t n, int perLine)
+{
+    for (uint32_t i = 0; i < n; i += perLine) {
+        fprintf(f, "   ");
+        for (uint32_t k = i; k < n && k < i + perLine; ++k) fprintf(f, " 0x%02X,", p[k]);
+        fprintf(f, "%s", NL);
+    }
+}
+
+static bool write_c(const char* path, const uint8_t* pack, uint32_t size,
+                    const std::vector<const char*>& maps)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    LevelPackView view;
+    view.open(pack, size);
+
+    const char* head[] = {
+        "/*",
+        "===============================================================================",
+        "  levels_data.cpp — Pack de niveaux intégré (flash)",
+        "-------------------------------------------------------------------------------",
+        "  Rôle :",
+        "    - Contient le pack de niveaux livré avec le jeu, au format binaire",
+        "      décrit dans levelpack.h (en-tête, index, un flux par niveau).",
+        "    - Utilisé par load_level() quand aucun pack n’est trouvé sur la carte SD",
+        "      (voir levels_open()).",
+        "",
+        "  Notes :",
+        "    - Fichier généré par levelc (host/levelc.cpp) depuis les cartes ASCII",
+        "      de assets/levels/ : modifier les cartes, pas ce fichier.",
+        "    - Mêmes octets que le fichier levels.pak : un pack copié sur la carte SD",
+        "      remplace celui-ci sans recompiler.",
+    };
+    for (const char* l : head) fprintf(f, "%s%s", l, NL);
+    fprintf(f, "    - %u octets pour %d niveaux.%s", (unsigned)size, view.count, NL);
+    fprintf(f, "===============================================================================%s*/%s%s",
+            NL, NL, NL);
+    fprintf(f, "#include \"levels.h\"%s%snamespace baba {%s%s", NL, NL, NL, NL);
+    fprintf(f, "const uint8_t LEVEL_PACK_BUILTIN[] = {%s", NL);
+
+    fprintf(f, "    // En-tête : \"BLVP\", version, %d niveaux, taille totale %u%s",
+            view.count, (unsigned)size, NL);
+    write_bytes(f, pack, LEVELPACK_HEADER, LEVELPACK_HEADER);
+    fprintf(f, "    // Index : décalage, taille, largeur × hauteur, position dans la carte%s", NL);
+    for (int i = 0; i < view.count; ++i)
+        write_bytes(f, pack + LEVELPACK_HEADER + i * LEVELPACK_ENTRY, LEVELPACK_ENTRY, LEVELPACK_ENTRY);
+    for (int i = 0; i < view.count; ++i) {
+        LevelPackEntry e;
+        view.entry(i, e);
+        fprintf(f, "    // Niveau %d : %s (%u octets)%s", i + 1, base_name(maps[i]), (unsigned)e.size, NL);
+        write_bytes(f, pack + e.offset, e.size, 16);
+    }
+
+    fprintf(f, "};%s%s", NL, NL);
+    fprintf(f, "const uint32_t LEVEL_PACK_BUILTIN_SIZE = sizeof(LEVEL_PACK_BUILTIN);%s%s", NL, NL);
+    fprintf(f, "} // namespace baba%s", NL);
+    return fclose(f) == 0;
+}
+
+// -----------------------------------------------------------------------------
+//  Compilation
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    const char* outPack = nullptr;
+    const char* outC    = nullptr;
+    const char* dumpDir = nullptr;
+    std::vector<const char*> maps;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-o") && i + 1 < argc)          outPack = argv[++i];
+        else if (!strcmp(argv[i], "--c") && i + 1 < argc)    outC = argv[++i];
+        else if (!strcmp(argv[i], "--dump") && i + 1 < argc) dumpDir = argv[++i];
+        else maps.push_back(argv[i]);
+    }
+
+    if (dumpDir) return dump(dumpDir, maps.empty() ? nullptr : maps[0]);
+
+    if (maps.empty() || (int)maps.size() > LEVELPACK_MAX) {
+        fprintf(stderr, "usage : levelc [-o levels.pak] [--c levels_data.cpp] carte.txt…\n"
+                        "        levelc --dump DOSSIER [levels.pak]\n");
+        return 2;
+    }
+
+    static Grid g;
+    static uint8_t pack[256 * 1024];
+    LevelPackBuilder b;
+    b.begin(pack, sizeof(pack), (int)maps.size());
+
+    int errors = 0;
+    for (const char* path : maps) {
+        std::string err;
+        if (!read_map(path, g, err)) {
+            fprintf(stderr, "%s : %s\n", path, err.c_str());
+            errors++;
+        } else if (!b.add(g)) {
+            fprintf(stderr, "%s : niveau trop gros pour le format\n", path);
+            errors++;
+        }
+    }
+    if (errors) return 1;
+
+    const uint32_t size = b.finish();
+    LevelPackView view;
+    if (!size || !view.open(pack, size)) {
+        fprintf(stderr, "assemblage du pack impossible\n");
+        return 1;
+    }
+
+    // Rapport : taille et temps de décodage par niveau
+    using Clock = std::chrono::steady_clock;
+    const int N = 2000;
+    uint32_t rawTotal = 0;
+    double   nsTotal  = 0.0;
+
+    printf("%-28s %5s | %7s %7s | %9s %9s | %s\n",
+           "carte", "level", "taille", "objets", "flux (o)", "brut (o)", "décodage (ns)");
+    for (int lv = 0; lv < view.count; ++lv) {
+        LevelPackEntry e;
+        view.entry(lv, e);
+        levelpack_decode(e, pack + e.offset, g);
+        int objects = 0;
+        for (int i = 0; i < g.cell_count(); ++i) objects += g.cell_at(i).objects.size();
+
+        auto t0 = Clock::now();
+        for (int k = 0; k < N; ++k) levelpack_decode(e, pack + e.offset, g);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / N;
+
+        const uint32_t raw = (uint32_t)e.width * e.height;
+        rawTotal += raw;
+        nsTotal  += ns;
+        char dims[16];
+        snprintf(dims, sizeof(dims), "%dx%d", e.width, e.height);
+        printf("%-28s %5d | %7s %7d | %9u %9u | %9.1f\n", maps[lv], lv + 1, dims, objects,
+               (unsigned)e.size, (unsigned)raw, ns);
+    }
+    printf("total : %d niveaux, pack %u octets (dont en-tête et index %d), brut %u octets,"
+           " décodage moyen %.1f ns\n",
+           view.count, (unsigned)size, LEVELPACK_HEADER + view.count * LEVELPACK_ENTRY,
+           (unsigned)rawTotal, nsTotal / view.count);
+
+    if (outPack) {
+        FILE* f = fopen(outPack, "wb");
+        bool ok = f && fwrite(pack, 1, size, f) == size;
+        if (f) ok &= fclose(f) == 0;
+        if (!ok) { fprintf(stderr, "%s : écriture impossible\n", outPack); return 1; }
+        printf("pack : %s\n", outPack);
+    }
+    if (outC) {
+        if (!write_c(outC, pack, size, maps)) { fprintf(stderr, "%s : écriture impossible\n", outC); return 1; }
+        printf("source : %s\n", outC);
+    }
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*
+===============================================================================
+  levelwatch.cpp — Rechargement à chaud d’un pack de niveaux sur PC (inotify)
+-------------------------------------------------------------------------------
+  Rôle :
+    - Équivalent hôte de LEVEL_HOT_RELOAD (game.cpp) : surveiller un pack
+      (.pak, produit par levelc) et recharger en place le niveau suivi dès
+      que le fichier change, avec le même chemin que la console
+      (levels_open, LevelCache::reload / load).
+    - Afficher l’état rechargé : dimensions, objets, règles actives.
+    - Garder les entrées d’une partie (--rec) et les rejouer sur le niveau
+      rechargé : une solution enregistrée gagne-t-elle encore ?
+
+  Notes :
+    - inotify surveille le dossier du pack (les éditeurs et levelc -o
+      remplacent souvent le fichier par renommage) ; seuls IN_CLOSE_WRITE
+      et IN_MOVED_TO sur le nom du pack sont retenus, puis les événements
+      d’une même rafale sont regroupés (WATCH_SETTLE_MS).
+    - inotify remplace ici le relevé de date / taille de la console (à la
+      seconde près, il manquerait deux écritures rapprochées de même
+      taille) ; comme sur la console, rien n’est réanalysé si le niveau
+      suivi est identique (autre niveau modifié).
+    - Linux uniquement (cible absente ailleurs, voir host/CMakeLists.txt).
+
+  Utilisation :
+    levelwatch levels.pak [niveau] [--rec partie.rec]
+    (boucle typique : levelc -o levels.pak avec les assets/levels/levelNN.txt,
+     à chaque sauvegarde d’une carte)
+
+  Compilation : voir host/CMakeLists.txt (cible levelwatch).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "core/grid.h"
+#include "core/rules.h"
+#include "core/undo.h"
+#include "core/replay.h"
+#include "core/vocabulary.h"
+#include "game/levels.h"
+#include "game/config.h"
+
+using namespace baba;
+
+// Délai de regroupement d’une rafale d’événements (écriture + renommage…)
+static const int WATCH_SETTLE_MS = 50;
+
+// -----------------------------------------------------------------------------
+//  Affichage
+// -----------------------------------------------------------------------------
+static const char* type_name(ObjectType t)
+{
+    static const char* names[] = {
+#define BABA_TYPE_NAME(type, kind, object, prop, tile) #type,
+        BABA_OBJECT_TYPES(BABA_TYPE_NAME)
+#undef BABA_TYPE_NAME
+    };
+    const char* n = names[(int)t];
+    return strncmp(n, "Text_", 5) ? n : n + 5;
+}
+
+static void print_rule(const Rule& r)
+{
+    std::string subjects;
+    for (TypeMask m = r.subjects; m; m &= m - 1) {
+        if (!subjects.empty()) subjects += " AND ";
+        subjects += type_name(lowest_type(m));
+    }
+    printf("    %s %s%s %s\n", subjects.c_str(), (r.flags & RULE_HAS) ? "HAS" : "IS",
+           (r.flags & RULE_NOT) ? " NOT" : "", type_name(r.word));
+}
+
+static void print_state(const Grid& g, const RuleSet& rules)
+{
+    int objects = 0;
+    for (int i = 0; i < g.cell_count(); ++i) objects += g.cell_at(i).objects.size();
+    printf("  %dx%d, %d objets, %d règle(s), empreinte %016llx\n",
+           g.playMaxX - g.playMinX + 1, g.playMaxY - g.playMinY + 1, objects, rules.count,
+           (unsigned long long)g.state_hash());
+    for (int i = 0; i < rules.count; ++i) print_rule(rules.rules[i]);
+}
+
+// -----------------------------------------------------------------------------
+//  Niveau suivi (état de jeu minimal) et entrées conservées
+// -----------------------------------------------------------------------------
+struct Session {
+    LevelCache    levels;
+    Grid          grid;
+    RuleSet       rules;
+    PropertyTable props;
+    UndoEntry     undoBuffer[UNDO_BUDGET_BYTES / sizeof(UndoEntry)];
+    UndoJournal   undo;
+    InputLog      log;
+    bool          hasLog = false;
+    int           level  = 0;
+
+    void load() {
+        undo.attach(undoBuffer, (int)(sizeof(undoBuffer) / sizeof(undoBuffer[0])));
+        grid.journal = &undo;
+        levels.load(level, grid, rules, props);
+    }
+
+    // Rejoue les entrées conservées sur l’état chargé
+    void replay() {
+        if (!hasLog) return;
+        MoveResult r;
+        uint32_t i = 0;
+        for (; i < log.count && !r.hasWon && !r.hasDied; ++i)
+            r = input_apply(grid, rules, props, &undo, log.at((int)i));
+        printf("  rejeu : %u / %u entrées -> %s\n", i, log.count,
+               r.hasWon ? "victoire" : r.hasDied ? "mort" : "en cours");
+    }
+};
+
+// -----------------------------------------------------------------------------
+//  Boucle de surveillance
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    const char* path    = nullptr;
+    const char* recPath = nullptr;
+    int level = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--rec") && i + 1 < argc) recPath = argv[++i];
+        else if (!path) path = argv[i];
+        else level = atoi(argv[i]) - 1;
+    }
+    if (!path) {
+        fprintf(stderr, "usage : levelwatch levels.pak [niveau] [--rec partie.rec]\n");
+        return 2;
+    }
+
+    setvbuf(stdout, nullptr, _IOLBF, 0);   // une ligne par événement, même redirigé
+
+    static Session s;
+    if (recPath) {
+        if (!input_log_load(s.log, recPath)) {
+            fprintf(stderr, "%s : journal illisible\n", recPath);
+            return 1;
+        }
+        s.hasLog = true;
+        if (level < 0) level = s.log.level;
+    }
+    s.level = level < 0 ? 0 : level;
+
+    if (!levels_open(path) || s.level >= levels_count()) {
+        fprintf(stderr, "%s : pack illisible ou niveau %d absent\n", path, s.level + 1);
+        return 1;
+    }
+    s.load();
+    printf("niveau %d (%s)\n", s.level + 1, path);
+    print_state(s.grid, s.rules);
+    s.replay();
+
+    // Dossier et nom du pack
+    std::string dir = path, name = path;
+    const size_t slash = dir.rfind('/');
+    if (slash == std::string::npos) dir = ".";
+    else { name = dir.substr(slash + 1); dir.resize(slash ? slash : 1); }
+
+    const int fd = inotify_init1(0);
+    if (fd < 0 || inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        perror("inotify");
+        return 1;
+    }
+    printf("surveillance de %s (Ctrl+C pour quitter)\n", path);
+
+    alignas(inotify_event) char buf[4096];
+    for (;;) {
+        // Attente d’un événement sur le pack, puis fin de la rafale
+        bool touched = false;
+        int  timeout = -1;
+        pollfd pfd = { fd, POLLIN, 0 };
+        while (poll(&pfd, 1, timeout) > 0) {
+            const ssize_t n = read(fd, buf, sizeof(buf));
+            if (n <= 0) break;
+            for (char* p = buf; p < buf + n; ) {
+                const inotify_event* ev = (const inotify_event*)p;
+                if (ev->len && name == ev->name) touched = true;
+                p += sizeof(inotify_event) + ev->len;
+            }
+            if (touched) timeout = WATCH_SETTLE_MS;
+        }
+        if (!touched) continue;
+
+        if (!levels_open(path)) {
+            printf("pack illisible, niveau %d conservé\n", s.level + 1);
+            continue;
+        }
+        if (s.level >= levels_count()) s.level = 0;
+
+        auto t0 = std::chrono::steady_clock::now();
+        if (!s.levels.reload(s.level)) {
+            printf("pack modifié, niveau %d inchangé\n", s.level + 1);
+            continue;
+        }
+        s.load();
+        const double us = std::chrono::duration<double, std::micro>(
+                              std::chrono::steady_clock::now() - t0).count();
+        printf("niveau %d rechargé en %.1f us\n", s.level + 1, us);
+        print_state(s.grid, s.rules);
+        s.replay();
+    }
+}
@@ -0,0 +1,215 @@
+/*
+===============================================================================
+  replay.cpp — Vérificateur de rejeu hôte (journaux d’entrées .rec)
+-------------------------------------------------------------------------------
+  Rôle :
+    - Rejouer des journaux enregistrés par la console (REPLAY_DIR, voir
+      game/config.h) aussi vite que possible, avec le vrai moteur :
+      load_level() puis input_apply() (step + rules_update, undo/redo).
+    - Comparer l’empreinte finale (Grid::state_hash) et les drapeaux
+      victoire / mort à ceux de l’enregistrement : couverture de
+      non-régression pour toute optimisation du moteur.
+    - Donner un débit (coups / seconde) à suivre de version en version.
+    - Générer un corpus de journaux (--record) par jeu aléatoire, avec
+      quelques undo/redo et en évitant les coups mortels, pour les
+      niveaux livrés.
+
+  Notes :
+    - L’empreinte initiale est vérifiée aussi : un journal dont le niveau
+      a changé depuis l’enregistrement est signalé comme tel.
+    - Le journal d’annulation est recréé avec la capacité notée dans le
+      fichier, pour que les coups oubliés le soient aussi au rejeu.
+
+  Utilisation :
+    replay [--repeat N] fichier.rec…
+    replay --record DOSSIER [--moves N]
+
+    Les journaux de référence des niveaux livrés sont dans host/replays
+    (test ctest « replay »).
+
+  Compilation : voir host/CMakeLists.txt (cible replay).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "core/grid.h"
+#include "core/rules.h"
+#include "core/movement.h"
+#include "core/undo.h"
+#include "core/replay.h"
+#include "game/levels.h"
+#include "game/config.h"
+
+using namespace baba;
+
+// Moteur complet pour un rejeu : grille, règles et journal d’annulation
+struct Engine {
+    Grid                   grid;
+    PropertyTable          props;
+    RuleSet                rules;
+    UndoJournal            undo;
+    std::vector<UndoEntry> undoBuffer;
+
+    void load(int level, int undoCap) {
+        undoBuffer.assign(undoCap, UndoEntry{});
+        undo.attach(undoBuffer.data(), undoCap);
+        grid.journal = &undo;
+        load_level(level, grid);
+        rules.count = 0;
+        rules_update(grid, rules, props);
+    }
+};
+
+struct Outcome {
+    bool     levelOk = true;   // empreinte initiale identique
+    bool     won = false, died = false;
+    uint64_t endHash = 0;
+};
+
+// Rejoue toutes les entrées du journal (la partie s’arrête à la victoire / mort)
+static Outcome run(Engine& e, const InputLog& log)
+{
+    Outcome o;
+    e.load(log.level, (int)log.undoCap);
+    o.levelOk = e.grid.state_hash() == log.startHash;
+
+    for (uint32_t i = 0; i < log.count; ++i) {
+        MoveResult r = input_apply(e.grid, e.rules, e.props, &e.undo, log.at((int)i));
+        o.won  = r.hasWon;
+        o.died = r.hasDied;
+        if (r.hasWon || r.hasDied) break;
+    }
+    o.endHash = e.grid.state_hash();
+    return o;
+}
+
+// ============================================================================
+//  Génération d’un corpus (jeu aléatoire, même chemin que la console)
+// ============================================================================
+static int record(const char* dir, int moves)
+{
+    static Engine e;
+    static InputLog log;
+    const int undoCap = UNDO_BUDGET_BYTES / (int)sizeof(UndoEntry);
+    uint32_t rng = 12345u;
+
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        e.load(lv, undoCap);
+        input_log_begin(log, lv, e.grid, undoCap);
+
+        MoveResult r;
+        for (int i = 0; i < moves && !log.truncated; ++i) {
+            rng = rng * 1664525u + 1013904223u;
+            uint32_t k = (rng >> 16) % 20;
+            InputCode c = k < 16 ? (InputCode)(k & 3) : (k < 19 ? INPUT_UNDO : INPUT_REDO);
+
+            // Éviter les coups mortels (essai sur une copie) pour obtenir
+            // des parties longues ; la mort reste possible en dernier recours
+            for (int tries = 0; c <= INPUT_DOWN && tries < 4; ++tries) {
+                static Grid probe;
+                probe = e.grid;
+                probe.journal = nullptr;
+                if (!step(probe, e.props, c == INPUT_LEFT ? -1 : c == INPUT_RIGHT ? 1 : 0,
+                          c == INPUT_UP ? -1 : c == INPUT_DOWN ? 1 : 0).hasDied) break;
+                c = (InputCode)((c + 1) & 3);
+            }
+
+            input_log_push(log, c);
+            r = input_apply(e.grid, e.rules, e.props, &e.undo, c);
+            if (r.hasWon || r.hasDied) break;
+        }
+        input_log_finish(log, e.grid, r.hasWon, r.hasDied);
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/level%02d.rec", dir, lv + 1);
+        if (!input_log_save(log, path)) {
+            fprintf(stderr, "écriture impossible : %s\n", path);
+            return 2;
+        }
+        printf("%s : %u entrées%s%s\n", path, log.count,
+               log.won ? ", victoire" : "", log.died ? ", mort" : "");
+    }
+    return 0;
+}
+
+// ============================================================================
+//  Vérification
+// ============================================================================
+int main(int argc, char** argv)
+{
+    int repeat = 100;
+    int moves  = 2000;
+    const char* recordDir = nullptr;
+    std::vector<const char*> files;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--repeat") && i + 1 < argc)      repeat = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--moves") && i + 1 < argc)  moves = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--record") && i + 1 < argc) recordDir = argv[++i];
+        else files.push_back(argv[i]);
+    }
+
+    if (recordDir) return record(recordDir, moves);
+
+    if (files.empty()) {
+        fprintf(stderr, "usage : replay [--repeat N] fichier.rec…\n"
+                        "        replay --record DOSSIER [--moves N]\n");
+        return 2;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    static Engine   e;
+    static InputLog log;
+    int    failures = 0;
+    double totalInputs = 0.0, totalSeconds = 0.0;
+
+    printf("%-28s %5s | %8s %6s %6s | %12s | %s\n",
+           "journal", "level", "inputs", "won", "died", "moves/s", "result");
+
+    for (const char* path : files) {
+        if (!input_log_load(log, path)) {
+            printf("%-28s illisible\n", path);
+            failures++;
+            continue;
+        }
+        if (log.level >= levels_count()) {
+            printf("%-28s niveau %d inconnu\n", path, log.level + 1);
+            failures++;
+            continue;
+        }
+
+        // Premier passage : vérification
+        Outcome o = run(e, log);
+        const char* verdict = "ok";
+        if (!o.levelOk)                                       verdict = "LEVEL CHANGED";
+        else if (o.endHash != log.endHash)                    verdict = "HASH DIFF";
+        else if (o.won != log.won || o.died != log.died)      verdict = "FLAGS DIFF";
+        if (strcmp(verdict, "ok")) failures++;
+
+        // Passages suivants : débit
+        auto t0 = Clock::now();
+        for (int k = 0; k < repeat; ++k) run(e, log);
+        double s = std::chrono::duration<double>(Clock::now() - t0).count();
+        double inputs = (double)log.count * repeat;
+        totalInputs  += inputs;
+        totalSeconds += s;
+
+        printf("%-28s %5d | %8u %6s %6s | %12.0f | %s%s\n", path, log.level + 1, log.count,
+               log.won ? "yes" : "no", log.died ? "yes" : "no",
+               s > 0 ? inputs / s : 0.0, verdict, log.truncated ? " (tronqué)" : "");
+    }
+
+    printf("total : %.0f entrées rejouées, %.0f coups/s, %d échec(s)\n",
+           totalInputs, totalSeconds > 0 ? totalInputs / totalSeconds : 0.0, failures);
+    return failures ? 1 : 0;
+}
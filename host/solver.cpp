@@ -0,0 +1,639 @@
+/*
+===============================================================================
+  solver.cpp — Solveur de niveaux hôte (BFS / A*, table de transposition)
+-------------------------------------------------------------------------------
+  Rôle :
+    - Résoudre les niveaux livrés (game/levels_data.cpp) avec le vrai moteur :
+      load_level(), rules_parse() et step() de core/.
+    - Vérifier que chaque niveau est soluble et donner la solution la plus
+      courte (BFS), ou une solution guidée par heuristique (A*).
+    - Servir de benchmark réaliste du moteur de déplacement : états
+      explorés par seconde, mémoire maximale.
+
+  Méthode :
+    - Un état = contenu de la grille (la zone jouable et les propriétés
+      se déduisent du niveau et des mots). Il est stocké sous forme
+      compacte : un uint16 par objet (case << 6 | type), dans l’ordre
+      des cases et des piles, plus un uint16 par objet orienté (MOVE).
+    - Table de transposition : adressage ouvert sur Grid::state_hash()
+      (empreinte Zobrist 64 bits tenue à jour par la grille).
+    - Développer un état : décodage dans une grille, rules_parse(), puis
+      pour chaque direction copie de la grille (memcpy) + step() et
+      transformations (NOUN IS NOUN), comme input_apply().
+    - Un coup sans effet redonne la même empreinte : il est ignoré.
+      Un coup mortel (hasDied) est une impasse, comme dans le jeu.
+    - A* : f = g + distance de Manhattan entre le YOU et le WIN les plus
+      proches. Les règles pouvant changer en un coup, l’heuristique n’est
+      pas admissible : la solution trouvée n’est pas garantie minimale.
+
+  Mode parallèle (--threads N) :
+    - BFS par couches : la couche courante est en lecture seule, chaque
+      thread développe ses nœuds dans sa propre copie de GameState et
+      écrit les enfants dans ses tampons locaux, fusionnés entre deux
+      couches. La solution reste la plus courte.
+    - Frontière à vol de travail : chaque thread reçoit une tranche de la
+      couche, la consomme par petits blocs, puis vole la moitié de la
+      tranche restante d’un autre thread quand la sienne est vide.
+    - Table des états visités sans verrou, découpée en fragments (bits de
+      poids fort de l’empreinte) : insertion par compare-and-swap.
+    - --scaling mesure chaque niveau de 1 à N threads (N = --threads,
+      par défaut le nombre de cœurs).
+
+  Utilisation :
+    solver [--astar] [--threads N] [--scaling] [--max-states N] [niveau…]
+    (niveaux numérotés dès 1)
+
+  Compilation : voir host/CMakeLists.txt (cible solver).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+
+#include "core/grid.h"
+#include "core/rules.h"
+#include "core/movement.h"
+#include "game/levels.h"
+#include "game/game.h"
+
+using namespace baba;
+
+static_assert(MAP_SIZE <= 1024 && (int)ObjectType::Count <= 64,
+              "encodage compact : 10 bits de case, 6 bits de type");
+
+static const int  DIRS[4][2]  = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+static const char DIR_NAME[4] = { 'L', 'R', 'U', 'D' };
+
+// ============================================================================
+//  Encodage compact d’un état
+// ============================================================================
+//  Un objet non orienté vers la droite (MOVE) est suivi d’une entrée
+//  d’orientation : case DIR_MARK (hors carte), orientation dans le champ type.
+constexpr uint16_t DIR_MARK = 1023;
+static_assert(MAP_SIZE <= DIR_MARK, "DIR_MARK doit être hors carte");
+
+static void encode(const Grid& g, std::vector<uint16_t>& out)
+{
+    for (int i = 0; i < g.cell_count(); ++i) {
+        if (!g.cellTypes[i]) continue;
+        for (const Object& o : g.cell_at(i).objects) {
+            out.push_back((uint16_t)(i << 6 | (int)o.type));
+            if (o.dir != DIR_RIGHT) out.push_back((uint16_t)(DIR_MARK << 6 | o.dir));
+        }
+    }
+}
+
+// Reconstruit la grille : la géométrie (taille, zone jouable) vient de ref.
+// false si un objet ne tient pas (état encodé depuis une grille : ne doit
+// pas arriver) ; le nœud est alors abandonné.
+static bool decode(const uint16_t* data, int count, const Grid& ref, Grid& g)
+{
+    g.reset(ref.width, ref.height);
+    g.playMinX = ref.playMinX;  g.playMinY = ref.playMinY;
+    g.playMaxX = ref.playMaxX;  g.playMaxY = ref.playMaxY;
+    for (int k = 0; k < count; ++k) {
+        const int cell = data[k] >> 6;
+        Object o{ (ObjectType)(data[k] & 63) };
+        if (k + 1 < count && (data[k + 1] >> 6) == DIR_MARK) o.dir = (uint8_t)(data[++k] & 63);
+        if (!g.stack_push(cell, o)) return false;
+    }
+    // Les règles sont analysées en entier par l’appelant
+    g.dirtyRows = g.dirtyCols = 0;
+    return true;
+}
+
+// ============================================================================
+//  Nœuds de recherche + table de transposition
+// ============================================================================
+struct Node {
+    uint32_t parent;   // index du nœud parent (UINT32_MAX pour la racine)
+    uint32_t offset;   // début de l’état dans l’arène
+    uint16_t count;    // nombre d’objets
+    uint8_t  dir;      // coup joué depuis le parent
+    uint16_t depth;
+};
+
+class Visited {
+public:
+    explicit Visited(size_t cap = 1 << 16) : keys_(cap, 0) {}
+
+    // Insère h ; retourne false s’il était déjà présent
+    bool insert(uint64_t h) {
+        if (h == 0) h = 1;   // 0 = case vide
+        if ((size_ + 1) * 2 > keys_.size()) grow();
+        size_t mask = keys_.size() - 1;
+        for (size_t i = h & mask; ; i = (i + 1) & mask) {
+            if (keys_[i] == h) return false;
+            if (keys_[i] == 0) { keys_[i] = h; size_++; return true; }
+        }
+    }
+
+    size_t bytes() const { return keys_.capacity() * sizeof(uint64_t); }
+
+private:
+    void grow() {
+        std::vector<uint64_t> old(keys_.size() * 2, 0);
+        old.swap(keys_);
+        size_ = 0;
+        for (uint64_t h : old) if (h) insert(h);
+    }
+
+    std::vector<uint64_t> keys_;
+    size_t size_ = 0;
+};
+
+struct Result {
+    bool        solved    = false;
+    bool        exhausted = false;   // espace entièrement exploré, sans solution
+    std::string moves;
+    size_t      states    = 0;       // états distincts rencontrés (morts compris)
+    size_t      expanded  = 0;
+    double      seconds   = 0.0;
+    size_t      peakBytes = 0;       // structures du solveur
+};
+
+// Heuristique A* : distance du YOU le plus proche au WIN le plus proche
+static int heuristic(const Grid& g, const PropertyTable& props)
+{
+    CellSet you = g.cells_with(props.types_with(PROP_YOU));
+    CellSet win = g.cells_with(props.types_with(PROP_WIN));
+    int best = 0x7FFF;
+    you.for_each([&](int a) {
+        win.for_each([&](int b) {
+            int d = std::abs(a % g.width - b % g.width) + std::abs(a / g.width - b / g.width);
+            best = std::min(best, d);
+        });
+    });
+    return best == 0x7FFF ? 0 : best;
+}
+
+// Un coup complet, comme input_apply() : step(), puis les transformations
+// (NOUN IS NOUN) avec les règles d’après le coup, réanalysées seulement si
+// un mot a bougé (grille décodée : lignes propres au départ)
+static MoveResult play(Grid& g, const PropertyTable& props, PropertyTable& after, int d)
+{
+    MoveResult r = step(g, props, DIRS[d][0], DIRS[d][1]);
+    const PropertyTable* now = &props;
+    if (g.dirtyRows | g.dirtyCols) {
+        rules_parse(g, after);
+        now = &after;
+    }
+    apply_transforms(g, *now);
+    return r;
+}
+
+// ============================================================================
+//  Recherche
+// ============================================================================
+static Result solve(int level, bool astar, size_t maxStates)
+{
+    using Clock = std::chrono::steady_clock;
+    auto t0 = Clock::now();
+
+    Result res;
+    static Grid root, base, work;
+    PropertyTable props, childProps;
+
+    load_level(level, root);
+
+    std::vector<Node>     nodes;
+    std::vector<uint16_t> arena;
+    Visited               visited;
+
+    // File : BFS = FIFO ; A* = tas sur (f, ordre d’insertion)
+    struct Entry { uint32_t f, seq, node; };
+    auto cmp = [](const Entry& a, const Entry& b) {
+        return a.f != b.f ? a.f > b.f : a.seq > b.seq;
+    };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(cmp)> open(cmp);
+    size_t fifo = 0;   // BFS : les nœuds sont développés dans l’ordre de création
+
+    auto add_node = [&](const Grid& g, uint32_t parent, uint8_t dir, uint16_t depth) {
+        Node n{ parent, (uint32_t)arena.size(), 0, dir, depth };
+        encode(g, arena);
+        n.count = (uint16_t)(arena.size() - n.offset);
+        nodes.push_back(n);
+        return (uint32_t)(nodes.size() - 1);
+    };
+
+    auto track_memory = [&]() {
+        size_t b = nodes.capacity() * sizeof(Node) + arena.capacity() * sizeof(uint16_t)
+                 + visited.bytes() + open.size() * sizeof(Entry);
+        res.peakBytes = std::max(res.peakBytes, b);
+    };
+
+    visited.insert(root.state_hash());
+    res.states = 1;
+    add_node(root, UINT32_MAX, 0, 0);
+    if (astar) {
+        rules_parse(root, props);
+        open.push({ (uint32_t)heuristic(root, props), 0, 0 });
+    }
+
+    uint32_t seq = 1;
+    int32_t  goal = -1;
+
+    while (goal < 0) {
+        uint32_t cur;
+        if (astar) {
+            if (open.empty()) break;
+            cur = open.top().node;
+            open.pop();
+        } else {
+            if (fifo >= nodes.size()) break;
+            cur = (uint32_t)fifo++;
+        }
+        if (nodes.size() >= maxStates) break;
+
+        const Node n = nodes[cur];
+        if (!decode(&arena[n.offset], n.count, root, base)) continue;
+        rules_parse(base, props);
+        res.expanded++;
+
+        for (int d = 0; d < 4 && goal < 0; ++d) {
+            work = base;
+            MoveResult r = play(work, props, childProps, d);
+            if (!visited.insert(work.state_hash())) continue;
+            res.states++;
+            if (r.hasDied && !r.hasWon) continue;   // impasse : le niveau est perdu
+
+            uint32_t child = add_node(work, cur, (uint8_t)d, (uint16_t)(n.depth + 1));
+            if (r.hasWon) { goal = (int32_t)child; break; }
+
+            if (astar) {
+                rules_parse(work, childProps);
+                open.push({ (uint32_t)(n.depth + 1 + heuristic(work, childProps)), seq++, child });
+            }
+        }
+        if ((res.expanded & 1023) == 0) track_memory();
+    }
+    track_memory();
+
+    res.seconds   = std::chrono::duration<double>(Clock::now() - t0).count();
+    res.solved    = goal >= 0;
+    res.exhausted = !res.solved && nodes.size() < maxStates;
+
+    for (uint32_t i = (uint32_t)goal; res.solved && nodes[i].parent != UINT32_MAX; i = nodes[i].parent)
+        res.moves.push_back(DIR_NAME[nodes[i].dir]);
+    std::reverse(res.moves.begin(), res.moves.end());
+    return res;
+}
+
+// ============================================================================
+//  Mode parallèle
+// ============================================================================
+/*
+    ShardedVisited :
+      Table des empreintes visitées partagée par tous les threads, sans
+      verrou. Les bits de poids fort de l’empreinte choisissent le
+      fragment, les bits de poids faible la case de départ du sondage
+      linéaire. Taille fixe (calculée depuis la limite d’états) : pas de
+      redimensionnement concurrent. Un fragment plein est signalé
+      (SHARD_FULL) : la recherche s’arrête comme à la limite d’états.
+*/
+class ShardedVisited {
+public:
+    static constexpr int SHARD_BITS = 6;
+    static constexpr int SHARDS     = 1 << SHARD_BITS;
+
+    explicit ShardedVisited(size_t maxStates) {
+        size_t perShard = 1024;
+        while (perShard * SHARDS < maxStates * 2) perShard <<= 1;
+        for (auto& sh : shards_) {
+            sh.keys.reset(new std::atomic<uint64_t>[perShard]);
+            for (size_t i = 0; i < perShard; ++i) sh.keys[i].store(0, std::memory_order_relaxed);
+            sh.mask = perShard - 1;
+        }
+    }
+
+    enum Insert { INSERTED, PRESENT, SHARD_FULL };
+
+    // INSERTED si h vient d’être inséré, PRESENT s’il l’était déjà,
+    // SHARD_FULL si son fragment n’a plus de place (h n’est pas retenu)
+    Insert insert(uint64_t h) {
+        if (h == 0) h = 1;
+        Shard& sh = shards_[h >> (64 - SHARD_BITS)];
+        size_t i = h & sh.mask;
+        for (size_t probe = 0; probe <= sh.mask; ++probe, i = (i + 1) & sh.mask) {
+            uint64_t cur = sh.keys[i].load(std::memory_order_relaxed);
+            if (cur == h) return PRESENT;
+            if (cur == 0) {
+                if (sh.keys[i].compare_exchange_strong(cur, h, std::memory_order_relaxed)) return INSERTED;
+                if (cur == h) return PRESENT;   // même état inséré par un autre thread
+            }
+        }
+        return SHARD_FULL;
+    }
+
+    size_t bytes() const { return SHARDS * (shards_[0].mask + 1) * sizeof(uint64_t); }
+
+private:
+    struct Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> keys;
+        size_t mask = 0;
+    };
+    Shard shards_[SHARDS];
+};
+
+/*
+    StealQueues :
+      Une tranche [lo, hi) de la couche courante par thread. Le propriétaire
+      prend des blocs de CHUNK nœuds par le bas ; un voleur prend la moitié
+      haute de la plus grande tranche restante.
+*/
+class StealQueues {
+public:
+    static constexpr size_t CHUNK = 8;
+
+    explicit StealQueues(int n) : n_(n), r_(new Range[n]) {}
+
+    void split(size_t begin, size_t end) {
+        size_t total = end - begin;
+        for (int t = 0; t < n_; ++t) {
+            r_[t].lo = begin + total * t / n_;
+            r_[t].hi = begin + total * (t + 1) / n_;
+        }
+    }
+
+    // Prochain bloc à développer pour le thread t ; false si tout est pris
+    bool take(int t, size_t& lo, size_t& hi) {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(r_[t].m);
+                if (r_[t].lo < r_[t].hi) {
+                    lo = r_[t].lo;
+                    hi = std::min(r_[t].hi, lo + CHUNK);
+                    r_[t].lo = hi;
+                    return true;
+                }
+            }
+            if (!steal(t)) return false;
+        }
+    }
+
+    uint64_t steals() const { return steals_.load(); }
+
+private:
+    bool steal(int t) {
+        // Victime : la tranche la plus longue (lecture approximative)
+        int victim = -1;
+        size_t best = 0;
+        for (int v = 0; v < n_; ++v) {
+            if (v == t) continue;
+            std::lock_guard<std::mutex> lock(r_[v].m);
+            size_t rem = r_[v].hi - r_[v].lo;
+            if (rem > best) { best = rem; victim = v; }
+        }
+        if (victim < 0) return false;
+
+        size_t lo, hi;
+        {
+            std::lock_guard<std::mutex> lock(r_[victim].m);
+            size_t rem = r_[victim].hi - r_[victim].lo;
+            if (rem == 0) return true;   // volée entre-temps : réessayer
+            size_t mid = r_[victim].lo + rem / 2;
+            lo = mid;
+            hi = r_[victim].hi;
+            r_[victim].hi = mid;
+        }
+        std::lock_guard<std::mutex> lock(r_[t].m);
+        r_[t].lo = lo;
+        r_[t].hi = hi;
+        steals_++;
+        return true;
+    }
+
+    struct alignas(64) Range {
+        std::mutex m;
+        size_t lo = 0, hi = 0;
+    };
+
+    int n_;
+    std::unique_ptr<Range[]> r_;
+    std::atomic<uint64_t> steals_{0};
+};
+
+static Result solve_parallel(int level, int threads, size_t maxStates)
+{
+    using Clock = std::chrono::steady_clock;
+    auto t0 = Clock::now();
+
+    Result res;
+    static Grid root;
+    load_level(level, root);
+
+    // Couches déjà produites : lecture seule pendant le développement
+    std::vector<Node>     nodes;
+    std::vector<uint16_t> arena;
+    ShardedVisited        visited(maxStates);
+
+    // Par thread : copie de l’état de jeu + enfants de la couche en cours
+    struct Worker {
+        GameState             state;
+        Grid                  work;
+        PropertyTable         after;   // règles d’après le coup (play)
+        std::vector<Node>     nodes;
+        std::vector<uint16_t> arena;
+        std::vector<uint32_t> goals;   // index locaux des nœuds gagnants
+        size_t                expanded = 0;
+    };
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int t = 0; t < threads; ++t) workers.emplace_back(new Worker);
+
+    StealQueues          queues(threads);
+    std::atomic<size_t>  states{1};
+    std::atomic<bool>    found{false};
+    std::atomic<bool>    full{false};
+
+    visited.insert(root.state_hash());
+    nodes.push_back(Node{ UINT32_MAX, 0, 0, 0, 0 });
+    encode(root, arena);
+    nodes[0].count = (uint16_t)arena.size();
+
+    // La limite est vérifiée à chaque nœud et à chaque enfant : elle n’est
+    // dépassée que d’un état au plus par thread
+    auto stopped = [&]() {
+        return found.load(std::memory_order_relaxed) || full.load(std::memory_order_relaxed);
+    };
+
+    auto expand = [&](int t) {
+        Worker& w = *workers[t];
+        size_t lo, hi;
+        while (!stopped() && queues.take(t, lo, hi)) {
+            for (size_t cur = lo; cur < hi && !full.load(std::memory_order_relaxed); ++cur) {
+                const Node& n = nodes[cur];
+                if (!decode(&arena[n.offset], n.count, root, w.state.grid)) continue;
+                rules_parse(w.state.grid, w.state.props);
+                w.expanded++;
+
+                for (int d = 0; d < 4 && !full.load(std::memory_order_relaxed); ++d) {
+                    w.work = w.state.grid;
+                    MoveResult r = play(w.work, w.state.props, w.after, d);
+                    const ShardedVisited::Insert ins = visited.insert(w.work.state_hash());
+                    if (ins == ShardedVisited::SHARD_FULL) { full = true; break; }
+                    if (ins == ShardedVisited::PRESENT) continue;
+                    // Limite atteinte en même temps par un autre thread : état
+                    // ni gardé ni compté
+                    const size_t seen = states.fetch_add(1, std::memory_order_relaxed) + 1;
+                    if (seen >= maxStates) full = true;
+                    if (seen > maxStates) break;
+                    if (r.hasDied && !r.hasWon) continue;
+
+                    Node c{ (uint32_t)cur, (uint32_t)w.arena.size(), 0, (uint8_t)d, (uint16_t)(n.depth + 1) };
+                    encode(w.work, w.arena);
+                    c.count = (uint16_t)(w.arena.size() - c.offset);
+                    w.nodes.push_back(c);
+                    if (r.hasWon) {
+                        w.goals.push_back((uint32_t)(w.nodes.size() - 1));
+                        found = true;
+                    }
+                }
+            }
+        }
+    };
+
+    size_t layerBegin = 0, layerEnd = 1;
+    int32_t goal = -1;
+
+    while (layerBegin < layerEnd && goal < 0 && !full) {
+        queues.split(layerBegin, layerEnd);
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; ++t) pool.emplace_back(expand, t);
+        expand(0);
+        for (auto& th : pool) th.join();
+
+        // Fusion des enfants (mono-thread, entre deux couches)
+        for (auto& wp : workers) {
+            Worker& w = *wp;
+            size_t base = nodes.size(), shift = arena.size();
+            if (goal < 0 && !w.goals.empty()) goal = (int32_t)(base + w.goals.front());
+            for (Node c : w.nodes) { c.offset += (uint32_t)shift; nodes.push_back(c); }
+            arena.insert(arena.end(), w.arena.begin(), w.arena.end());
+            w.nodes.clear();
+            w.arena.clear();
+            w.goals.clear();
+        }
+        res.peakBytes = std::max(res.peakBytes,
+                                 nodes.capacity() * sizeof(Node) + arena.capacity() * sizeof(uint16_t)
+                                 + visited.bytes());
+
+        layerBegin = layerEnd;
+        layerEnd   = nodes.size();
+    }
+
+    for (auto& wp : workers) res.expanded += wp->expanded;
+    res.states    = std::min(states.load(), maxStates);
+    res.seconds   = std::chrono::duration<double>(Clock::now() - t0).count();
+    res.solved    = goal >= 0;
+    res.exhausted = !res.solved && !full;
+
+    for (uint32_t i = (uint32_t)goal; res.solved && nodes[i].parent != UINT32_MAX; i = nodes[i].parent)
+        res.moves.push_back(DIR_NAME[nodes[i].dir]);
+    std::reverse(res.moves.begin(), res.moves.end());
+    return res;
+}
+
+int main(int argc, char** argv)
+{
+    bool   astar     = false;
+    bool   scaling   = false;
+    int    threads   = 0;   // 0 = recherche séquentielle
+    size_t maxStates = 2000000;
+    std::vector<int> todo;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--astar")) astar = true;
+        else if (!strcmp(argv[i], "--scaling")) scaling = true;
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--max-states") && i + 1 < argc) maxStates = strtoull(argv[++i], nullptr, 10);
+        else {
+            int lv = atoi(argv[i]);
+            if (lv < 1 || lv > levels_count()) {
+                fprintf(stderr, "niveau invalide : %s (1..%d)\n", argv[i], levels_count());
+                return 2;
+            }
+            todo.push_back(lv - 1);
+        }
+    }
+    if (todo.empty())
+        for (int lv = 0; lv < levels_count(); ++lv) todo.push_back(lv);
+
+    if (scaling) {
+        int maxThreads = threads > 0 ? threads : (int)std::max(1u, std::thread::hardware_concurrency());
+        std::vector<int> counts;
+        for (int n = 1; n < maxThreads; n *= 2) counts.push_back(n);
+        counts.push_back(maxThreads);
+
+        printf("solver — BFS parallèle, 1 à %d threads, limite %zu états\n", maxThreads, maxStates);
+        printf("%-6s | %-10s %6s |", "level", "result", "moves");
+        for (int n : counts) printf(" %7dT", n);
+        printf(" | speedup\n");
+
+        for (int lv : todo) {
+            double t1 = 0.0, tn = 0.0;
+            Result first;
+            for (size_t k = 0; k < counts.size(); ++k) {
+                Result r = solve_parallel(lv, counts[k], maxStates);
+                if (k == 0) { first = r; t1 = r.seconds; printf("%-6d | %-10s %6zu |", lv + 1,
+                    r.solved ? "solved" : (r.exhausted ? "unsolvable" : "limit"), r.moves.size()); }
+                else if (r.solved != first.solved || r.moves.size() != first.moves.size())
+                    printf(" (DIFF)");
+                tn = r.seconds;
+                printf(" %7.3fs", r.seconds);
+                fflush(stdout);
+            }
+            printf(" | x%.2f\n", tn > 0 ? t1 / tn : 0.0);
+        }
+        return 0;
+    }
+
+    if (threads > 0)
+        printf("solver — BFS parallèle (%d threads), limite %zu états\n", threads, maxStates);
+    else
+        printf("solver — %s, limite %zu états\n", astar ? "A*" : "BFS", maxStates);
+    printf("%-6s | %-10s %6s | %10s %10s %12s %10s | %s\n",
+           "level", "result", "moves", "states", "expanded", "states/s", "mem (Ko)", "solution");
+
+    int unsolved = 0;
+    size_t totalStates = 0;
+    double totalSeconds = 0.0;
+
+    for (int lv : todo) {
+        Result r = threads > 0 ? solve_parallel(lv, threads, maxStates)
+                               : solve(lv, astar, maxStates);
+        totalStates  += r.states;
+        totalSeconds += r.seconds;
+        if (!r.solved) unsolved++;
+
+        const char* status = r.solved ? "solved" : (r.exhausted ? "unsolvable" : "limit");
+        printf("%-6d | %-10s %6zu | %10zu %10zu %12.0f %10zu | %s\n", lv + 1, status,
+               r.moves.size(), r.states, r.expanded,
+               r.seconds > 0 ? r.states / r.seconds : 0.0, r.peakBytes / 1024,
+               r.moves.c_str());
+        fflush(stdout);
+    }
+
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    printf("total  | %zu états en %.2f s (%.0f états/s), RSS max %ld Ko\n",
+           totalStates, totalSeconds, totalSeconds > 0 ? totalStates / totalSeconds : 0.0,
+           ru.ru_maxrss);
+
+    return unsolved ? 1 : 0;
+}
@@ -0,0 +1,1085 @@
+/*
+===============================================================================
+  test_engine.cpp — Tests hôtes du moteur (ctest)
+-------------------------------------------------------------------------------
+  Rôle :
+    - Vérifier le moteur sur PC, sans mesure de temps (voir bench_grid) :
+        * arène plate == ancien moteur (fixtures.h) sur les niveaux livrés,
+          rules_update() == rules_parse(), index par type == parcours de
+          la carte, empreinte incrémentale == recalcul complet ;
+        * journal d’annulation : tout annuler = état initial, tout
+          rejouer = état final, redo rend victoire / mort ;
+        * résolution groupée des YOU (niveau de stress) == référence ;
+        * phase MOVE : rebond, empreinte, annulation, YOU et MOVE ;
+        * interactions et effets WIN / KILL : passe incrémentale == passe
+          complète (niveaux livrés, soupes aléatoires) ;
+        * transformations, analyseur de phrases, événements de règles
+          (débordement de MAX_RULES compris) ;
+        * chaîne de PUSH à travers une case mixte (ROCK sur FLAG) ;
+        * capacité des piles : case pleine, pool de débordement épuisé ;
+        * aucune allocation dans input_apply() (operator new compté) ;
+        * pack de niveaux : réencodage à l’octet près, fichier == intégré,
+          pack tronqué refusé sans toucher au pack actif, flux corrompus
+          rejetés.
+    - Une ligne par vérification (ok / ÉCHEC) ; code de sortie 1 si l’une
+      d’elles échoue.
+
+  Utilisation :
+    ctest --test-dir build-host      (ou ./build-host/test_engine)
+
+  Compilation : voir host/CMakeLists.txt (cible test_engine).
+
+  Auteur : Jean-Charles LEBEAU
+  Date   : Janvier 2026
+===============================================================================
+*/
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "fixtures.h"
+
+static int g_failed = 0;
+
+// ============================================================================
+//  Compteur d’allocations (remplace l’operator new global du programme ;
+//  seules les différences autour d’input_apply() sont lues, voir
+//  check_no_alloc())
+// ============================================================================
+static std::atomic<uint64_t> g_allocs{0};
+
+void* operator new(size_t n)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t n)                   { return operator new(n); }
+void  operator delete(void* p) noexcept          { std::free(p); }
+void  operator delete[](void* p) noexcept        { std::free(p); }
+void  operator delete(void* p, size_t) noexcept  { std::free(p); }
+void  operator delete[](void* p, size_t) noexcept{ std::free(p); }
+
+static void expect(bool ok, const char* what)
+{
+    printf("%-6s %s\n", ok ? "ok" : "ÉCHEC", what);
+    if (!ok) g_failed++;
+}
+
+// ============================================================================
+//  Niveaux livrés : coups aléatoires sur les deux moteurs (rechargement sur
+//  victoire / mort), états comparés après chaque coup
+// ============================================================================
+static bool check_levels(int moves)
+{
+    static Grid g;
+    static legacy::Grid old;
+    static RuleSet rules;
+    PropertyTable props, full;
+    legacy::PropertyTable oldProps;
+    bool ok = true;
+
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        Lcg rng{ 1234u + (uint32_t)lv };
+        load_level(lv, g);
+        rules.count = 0;
+        rules_update(g, rules, props);
+        legacy::load_level(lv, old);
+        legacy::rules_parse(old, oldProps);
+
+        for (int i = 0; i < moves; ++i) {
+            const int* d = DIRS[rng.next() & 3];
+            MoveResult r = step(g, props, d[0], d[1]);
+            rules_update(g, rules, props);
+            MoveResult o = legacy::step(old, oldProps, d[0], d[1]);
+            legacy::rules_parse(old, oldProps);
+
+            rules_parse(g, full);
+            ok &= same_state(g, old) && r.hasWon == o.hasWon && r.hasDied == o.hasDied;
+            ok &= same_props(props, full);
+            ok &= find_you_scan(g, props) == g.first_cell_with(props.types_with(PROP_YOU));
+            ok &= g.hash == g.compute_hash();
+
+            if (r.hasWon || r.hasDied) {
+                load_level(lv, g);
+                rules_update(g, rules, props);
+                legacy::load_level(lv, old);
+                legacy::rules_parse(old, oldProps);
+            }
+        }
+        if (!ok) { printf("       niveau %d\n", lv + 1); return false; }
+    }
+    return ok;
+}
+
+// Journal d’annulation, niveau par niveau (au moins UNDO_MIN_UNDONE coups
+// annulés par niveau : un journal presque vide ne prouve rien)
+static bool check_undo()
+{
+    static Grid g;
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        const UndoCheck u = run_undo(g, lv);
+        if (!u.ok || u.undone < UNDO_MIN_UNDONE) {
+            printf("       niveau %d : %ld coups annulés\n", lv + 1, u.undone);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Coup imbriqué (input_apply / step) trop grand pour le tampon : le coup
+// reste perdu jusqu’au end_move() externe, rien n’en est annulable
+static bool check_undo_nested()
+{
+    static Grid g;
+    UndoEntry   buffer[16];
+    UndoJournal journal(buffer, 16);
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.journal = &journal;
+
+    journal.begin_move();
+    journal.begin_move();
+    for (int i = 0; i < 20; ++i) g.stack_push(i, {ObjectType::Rock});
+    journal.end_move();
+    journal.begin_move();
+    for (int i = 0; i < 2; ++i) g.stack_push(i, {ObjectType::Flag});
+    journal.end_move();
+    journal.end_move();
+    bool ok = !journal.can_undo() && !journal.can_redo();
+
+    // Coup suivant : de nouveau annulable
+    journal.begin_move();
+    g.stack_push(0, {ObjectType::Baba});
+    journal.end_move();
+    ok &= journal.undo(g) && !(g.cellTypes[0] & type_bit(ObjectType::Baba)) && !journal.can_undo();
+    g.journal = nullptr;
+    return ok;
+}
+
+// Redo : victoire / mort du coup d’origine. Baba rejoint le drapeau (WIN),
+// annulation, rejeu : hasWon. Baba coule avec un rocher SINK : la grille
+// rejouée n’a plus de YOU, le rejeu rend tout de même hasDied.
+static bool check_redo_result()
+{
+    using T = ObjectType;
+    static Grid g;
+    static RuleSet rules;
+    static UndoEntry buffer[256];
+    UndoJournal journal(buffer, 256);
+    PropertyTable props;
+
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+    g.journal = &journal;
+    place_words(g, 0, 0, { T::Text_Baba, T::Text_Is, T::Text_You });
+    place_words(g, 0, 1, { T::Text_Flag, T::Text_Is, T::Text_Win });
+    place_words(g, 0, 2, { T::Text_Rock, T::Text_Is, T::Text_Sink });
+    place_words(g, 4, 5, { T::Baba, T::Flag });
+    place_words(g, 4, 8, { T::Baba, T::Rock });
+    rules.count = 0;
+    rules_update(g, rules, props);
+
+    MoveResult r = input_apply(g, rules, props, &journal, INPUT_RIGHT);
+    bool ok = r.hasWon && r.hasDied;   // un Baba gagne, l’autre coule
+    r = input_apply(g, rules, props, &journal, INPUT_UNDO);
+    ok &= !r.hasWon && !r.hasDied;
+    r = input_apply(g, rules, props, &journal, INPUT_REDO);
+    ok &= r.hasWon && r.hasDied;
+    ok &= g.cellTypes[8 * g.width + 5] == 0;
+
+    // Coup ordinaire rejoué : ni victoire, ni mort
+    input_apply(g, rules, props, &journal, INPUT_UNDO);
+    input_apply(g, rules, props, &journal, INPUT_DOWN);
+    input_apply(g, rules, props, &journal, INPUT_UNDO);
+    r = input_apply(g, rules, props, &journal, INPUT_REDO);
+    ok &= !r.hasWon && !r.hasDied;
+
+    g.journal = nullptr;
+    return ok;
+}
+
+// Niveau de stress : un coup par direction sur les deux moteurs
+static bool check_stress()
+{
+    static Grid base, work;
+    static legacy::Grid oldBase, oldWork;
+    PropertyTable props;
+    legacy::PropertyTable oldProps;
+
+    base.reset(MAP_WIDTH, MAP_HEIGHT);
+    build_stress(base);
+    rules_parse(base, props);
+    oldBase = legacy::Grid(MAP_WIDTH, MAP_HEIGHT);
+    build_stress(oldBase);
+    legacy::rules_parse(oldBase, oldProps);
+
+    bool ok = true;
+    for (int d = 0; d < 4; ++d) {
+        work = base;
+        step(work, props, DIRS[d][0], DIRS[d][1]);
+        oldWork = oldBase;
+        legacy::step(oldWork, oldProps, DIRS[d][0], DIRS[d][1]);
+        ok &= same_state(work, oldWork) && work.hash == work.compute_hash();
+    }
+    return ok;
+}
+
+// ============================================================================
+//  Phase MOVE
+//  - Rebond simple (couloir de 3 cases entre deux murs).
+//  - Rochers MOVE (build_movers) : coups aléatoires journalisés, empreinte
+//    incrémentale contre recalcul complet, tout annuler = état initial,
+//    tout rejouer = état final.
+//  - Plus de MAX_MOVERS mobiles (300 rochers espacés, rangées alternées
+//    droite / gauche) : traités en lots, chacun avance d’une case, une fois.
+// ============================================================================
+static bool check_bounce()
+{
+    static Grid g;
+    PropertyTable props;
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+    const ObjectType words[] = {
+        ObjectType::Text_Rock, ObjectType::Text_Is, ObjectType::Text_Move,
+        ObjectType::Empty,
+        ObjectType::Text_Wall, ObjectType::Text_Is, ObjectType::Text_Stop,
+    };
+    for (int x = 0; x < 7; ++x)
+        if (words[x] != ObjectType::Empty) g.cell(x, 0).objects.push_back({words[x]});
+    g.cell(0, 2).objects.push_back({ObjectType::Wall});
+    g.cell(4, 2).objects.push_back({ObjectType::Wall});
+    g.cell(1, 2).objects.push_back({ObjectType::Rock});
+    rules_parse(g, props);
+
+    // Position du rocher après chaque coup (un YOU absent : seul MOVE agit)
+    const int expected[] = { 2, 3, 2, 1, 2, 3, 2 };
+    for (int x : expected) {
+        step(g, props, 0, 0);
+        if (g.first_cell_with(type_bit(ObjectType::Rock)) != 2 * g.width + x) return false;
+    }
+    return g.hash == g.compute_hash();
+}
+
+static bool check_move(int turns)
+{
+    static Grid initial, g, final;
+    static RuleSet rules;
+    static std::vector<UndoEntry> buffer(1 << 20);
+    UndoJournal journal(buffer.data(), (int)buffer.size());
+    PropertyTable props;
+
+    build_movers(initial);
+    g = initial;
+    g.journal = &journal;
+    rules.count = 0;
+    rules_update(g, rules, props);
+
+    bool ok = true;
+    Lcg rng{ 99u };
+    for (int i = 0; i < turns; ++i) {
+        const int* d = DIRS[rng.next() & 3];
+        step(g, props, d[0], d[1]);
+        rules_update(g, rules, props);
+        ok &= g.hash == g.compute_hash();
+    }
+    final = g;
+
+    while (journal.undo(g)) rules_update(g, rules, props);
+    ok &= same_grid(g, initial) && g.hash == initial.hash;
+    while (journal.redo(g)) rules_update(g, rules, props);
+    ok &= same_grid(g, final) && g.hash == final.hash;
+    g.journal = nullptr;
+    return ok;
+}
+
+static bool check_many_movers()
+{
+    static Grid g;
+    PropertyTable props;
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+    place_words(g, 0, 0, { ObjectType::Text_Rock, ObjectType::Text_Is, ObjectType::Text_Move });
+    for (int y = 2; y < 22; ++y)
+        for (int x = 2; x < 32; x += 2)
+            g.cell(x, y).objects.push_back({ObjectType::Rock, (uint8_t)(y & 1 ? DIR_LEFT : DIR_RIGHT)});
+    rules_parse(g, props);
+    step(g, props, 0, 0);
+
+    bool ok = g.hash == g.compute_hash();
+    for (int y = 2; y < 22; ++y)
+        for (int x = 0; x < MAP_WIDTH; ++x) {
+            const auto& objs = g.cell(x, y).objects;
+            const int   from = x + (y & 1 ? 1 : -1);   // case de départ
+            ok &= objs.size() == ((x & 1) && from >= 2 && from < 32 ? 1 : 0);
+            if (!objs.empty()) ok &= objs[0].dir == (y & 1 ? DIR_LEFT : DIR_RIGHT);
+        }
+    return ok;
+}
+
+// BABA IS YOU AND MOVE : Baba prend l’orientation de chaque coup joué et
+// continue dans ce sens pendant la phase MOVE (attente comprise) ; un undo
+// rend l’orientation d’avant le coup
+static bool check_you_move()
+{
+    using T = ObjectType;
+    static Grid g;
+    static UndoEntry buffer[256];
+    UndoJournal journal(buffer, 256);
+    PropertyTable props;
+
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+    g.journal = &journal;
+    place_words(g, 0, 0, { T::Text_Baba, T::Text_Is, T::Text_You, T::Text_And, T::Text_Move });
+    place_words(g, 10, 10, { T::Baba });
+    rules_parse(g, props);
+
+    auto baba = [&](int x, int y, uint8_t dir) {
+        const auto& objs = g.cell(x, y).objects;
+        return g.cellTypes[y * g.width + x] == type_bit(T::Baba) && objs[0].dir == dir;
+    };
+
+    bool ok = true;
+    step(g, props, -1, 0);                  // YOU puis MOVE : deux cases à gauche
+    ok &= baba(8, 10, DIR_LEFT);
+    step(g, props, 0, 0);                   // attente : MOVE seul, toujours à gauche
+    ok &= baba(7, 10, DIR_LEFT);
+    step(g, props, 0, 1);
+    ok &= baba(7, 12, DIR_DOWN);
+    ok &= g.hash == g.compute_hash();
+    journal.undo(g);
+    ok &= baba(7, 10, DIR_LEFT) && g.hash == g.compute_hash();
+
+    g.journal = nullptr;
+    return ok;
+}
+
+// ============================================================================
+//  Interactions et effets : passe incrémentale == passe complète
+//  (run_lockstep, fixtures.h), niveaux livrés puis soupes aléatoires
+// ============================================================================
+static bool check_effects_levels()
+{
+    static Grid inc, full;
+    EffectCheck c;
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        load_level(lv, inc);
+        full = inc;
+        run_lockstep(inc, full, 4242u + (uint32_t)lv, 5000, c);
+    }
+    return c.ok;
+}
+
+static bool check_effects_soups()
+{
+    static Grid inc, full;
+    EffectCheck c;
+    for (uint32_t seed = 1; seed <= 32; ++seed) {
+        build_soup(inc, seed);
+        full = inc;
+        run_lockstep(inc, full, seed, 3000, c);
+    }
+    return c.ok;
+}
+
+// ============================================================================
+//  Transformations (NOUN IS NOUN) : chaîne, division, protection, EMPTY
+//  - Deux coups sans YOU (seules les transformations agissent), puis un
+//    undo qui doit annuler la transformation avec le coup.
+// ============================================================================
+static bool check_transforms()
+{
+    using T = ObjectType;
+    static Grid g, afterFirst;
+    static RuleSet rules;
+    static UndoEntry buffer[256];
+    UndoJournal journal(buffer, 256);
+    PropertyTable props;
+
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+    const T words[3][7] = {
+        { T::Text_Baba, T::Text_Is, T::Text_Rock, T::Empty, T::Text_Rock, T::Text_Is, T::Text_Flag  },
+        { T::Text_Rock, T::Text_Is, T::Text_Love, T::Empty, T::Text_Flag, T::Text_Is, T::Text_Flag  },
+        { T::Text_Flag, T::Text_Is, T::Text_Baba, T::Empty, T::Text_Love, T::Text_Is, T::Text_Empty },
+    };
+    for (int y = 0; y < 3; ++y)
+        for (int x = 0; x < 7; ++x)
+            if (words[y][x] != T::Empty) g.cell(x, y).objects.push_back({words[y][x]});
+    g.cell(1, 5).objects.push_back({T::Baba});
+    g.cell(3, 5).objects.push_back({T::Rock});
+    g.cell(5, 5).objects.push_back({T::Flag, DIR_UP});
+    g.cell(7, 5).objects.push_back({T::Love});
+    g.journal = &journal;
+    rules.count = 0;
+    rules_update(g, rules, props);
+
+    auto stack_is = [&](int x, std::initializer_list<T> types) {
+        auto st = g.cell(x, 5).objects;
+        if (st.size() != (int)types.size()) return false;
+        int k = 0;
+        for (T t : types) if (st[k++].type != t) return false;
+        return true;
+    };
+
+    bool ok = true;
+    input_apply(g, rules, props, &journal, INPUT_RIGHT);
+    ok &= stack_is(1, { T::Rock });               // BABA IS ROCK (pas de baba → drapeau)
+    ok &= stack_is(3, { T::Flag, T::Love });      // ROCK IS FLAG + ROCK IS LOVE : division
+    ok &= stack_is(5, { T::Flag });               // FLAG IS FLAG : protégé
+    ok &= g.cell(5, 5).objects[0].dir == DIR_UP;
+    ok &= stack_is(7, {});                        // LOVE IS EMPTY
+    afterFirst = g;
+
+    // Aucun mot transformé : aucune ligne à réanalyser
+    static Grid probe;
+    probe = g;
+    probe.journal = nullptr;
+    ok &= apply_transforms(probe, props) > 0 && (probe.dirtyRows | probe.dirtyCols) == 0;
+
+    input_apply(g, rules, props, &journal, INPUT_RIGHT);
+    ok &= stack_is(1, { T::Flag, T::Love });
+    ok &= stack_is(3, { T::Flag });
+    ok &= g.hash == g.compute_hash();
+
+    // Un seul undo annule le coup et ses transformations
+    input_apply(g, rules, props, &journal, INPUT_UNDO);
+    ok &= same_grid(g, afterFirst) && g.hash == afterFirst.hash;
+    g.journal = nullptr;
+    return ok;
+}
+
+// ============================================================================
+//  Analyseur de phrases : AND, NOT, HAS, ON
+//  - Table attendue pour quelques phrases, puis deux coups sous condition
+//    (BABA ON FLAG IS YOU) avec une destruction SINK qui laisse un objet (HAS).
+//  - Soupe de mots aléatoire : rules_update() doit rester identique à
+//    rules_parse() après chaque ajout / retrait de mot.
+// ============================================================================
+static bool check_parser(int mutations)
+{
+    using T = ObjectType;
+    static Grid g;
+    static RuleSet rules;
+    PropertyTable props, full;
+    bool ok = true;
+
+    auto reset = [&]() {
+        g.reset(MAP_WIDTH, MAP_HEIGHT);
+        g.playMaxX = MAP_WIDTH - 1;
+        g.playMaxY = MAP_HEIGHT - 1;
+        g.journal = nullptr;
+    };
+
+    // 1) Table attendue
+    reset();
+    place_words(g, 0,  0, { T::Text_Baba, T::Text_And, T::Text_Rock, T::Text_Is, T::Text_Push });
+    place_words(g, 0,  2, { T::Text_Not, T::Text_Love, T::Text_Is, T::Text_Stop });
+    place_words(g, 0,  4, { T::Text_Rock, T::Text_Is, T::Text_Not, T::Text_Stop });
+    place_words(g, 0,  6, { T::Text_Flag, T::Text_Is, T::Text_Win, T::Text_And,
+                            T::Text_Rock, T::Text_Is, T::Text_Sink });
+    place_words(g, 0,  8, { T::Text_Baba, T::Text_On, T::Text_Flag, T::Text_Is, T::Text_You });
+    place_words(g, 0, 10, { T::Text_Love, T::Text_Has, T::Text_Flag });
+    place_words(g, 0, 12, { T::Text_Wall, T::Text_Baba, T::Text_Is, T::Text_Kill });   // WALL ignoré
+    g.cell(25, 0).objects.push_back({T::Text_Goop});
+    g.cell(25, 1).objects.push_back({T::Text_Is});
+    g.cell(25, 2).objects.push_back({T::Text_Melt});
+
+    rules_parse(g, full);
+    rules.count = 0;
+    rules_update(g, rules, props);
+    ok &= same_props(props, full);
+
+    ok &= props.has(T::Baba, PROP_PUSH) && props.has(T::Rock, PROP_PUSH) && !props.has(T::Wall, PROP_PUSH);
+    ok &= props.has(T::Wall, PROP_STOP) && props.has(T::Baba, PROP_STOP);
+    ok &= !props.has(T::Rock, PROP_STOP) && !props.has(T::Love, PROP_STOP);   // NOT l’emporte
+    ok &= props.has(T::Flag, PROP_WIN) && props.has(T::Rock, PROP_SINK);      // ROCK ouvre la 2e phrase
+    ok &= props.becomes[(int)T::Flag] == type_bit(T::Rock);
+    ok &= !props.has(T::Baba, PROP_YOU) && props.condCount == 1;
+    ok &= (props.types_at(PROP_YOU, type_bit(T::Baba) | type_bit(T::Flag)) & type_bit(T::Baba)) != 0;
+    ok &= (props.types_at(PROP_YOU, type_bit(T::Baba)) & type_bit(T::Baba)) == 0;
+    ok &= props.holds[(int)T::Love] == type_bit(T::Flag);
+    ok &= props.has(T::Baba, PROP_KILL) && !props.has(T::Wall, PROP_KILL);
+    ok &= props.has(T::Goop, PROP_MELT);                                       // verticale
+
+    // 2) Coups sous condition, destruction avec possession
+    reset();
+    place_words(g, 0, 0, { T::Text_Baba, T::Text_On, T::Text_Flag, T::Text_Is, T::Text_You });
+    place_words(g, 0, 2, { T::Text_Rock, T::Text_Is, T::Text_Push });
+    place_words(g, 0, 4, { T::Text_Love, T::Text_Is, T::Text_Sink });
+    place_words(g, 0, 6, { T::Text_Love, T::Text_Has, T::Text_Flag });
+    place_words(g, 1, 14, { T::Baba });
+    place_words(g, 1, 14, { T::Flag });
+    place_words(g, 6, 14, { T::Baba });
+    place_words(g, 1, 16, { T::Baba, T::Rock, T::Love });
+    place_words(g, 1, 16, { T::Flag });
+    rules.count = 0;
+    rules_update(g, rules, props);
+
+    auto types_at = [&](int x, int y) { return g.cellTypes[y * g.width + x]; };
+    step(g, props, 1, 0);
+    ok &= types_at(1, 14) == type_bit(T::Flag) && types_at(2, 14) == type_bit(T::Baba);
+    ok &= types_at(6, 14) == type_bit(T::Baba);                       // pas sur un drapeau
+    ok &= types_at(2, 16) == type_bit(T::Baba);
+    ok &= types_at(3, 16) == type_bit(T::Flag);   // ROCK et LOVE coulent, LOVE laisse FLAG
+    const uint64_t h = g.hash;
+    step(g, props, 1, 0);
+    ok &= g.hash == h && g.hash == g.compute_hash();                  // plus aucun YOU
+
+    // 3) Soupe de mots : incrémental == complet
+    reset();
+    const T vocab[] = {
+        T::Text_Baba, T::Text_Rock, T::Text_Flag, T::Text_Wall, T::Text_Empty,
+        T::Text_Is, T::Text_Is, T::Text_Is, T::Text_Has, T::Text_And, T::Text_And,
+        T::Text_Not, T::Text_On, T::Text_You, T::Text_Push, T::Text_Stop, T::Text_Win, T::Text_Sink,
+    };
+    const int nv = (int)(sizeof(vocab) / sizeof(vocab[0]));
+    uint32_t rng = 777u;
+    auto next = [&](uint32_t n) { rng = rng * 1664525u + 1013904223u; return (rng >> 8) % n; };
+
+    rules.count = 0;
+    g.mark_all_text_dirty();
+    int diffs = 0;
+    for (int i = 0; i < mutations; ++i) {
+        const int index = (int)next(8) * g.width + (int)next(12);
+        if (g.slots[index].count && next(2)) g.stack_erase(index, 0, 1);
+        else g.stack_push(index, Object{ vocab[next(nv)] });
+
+        rules_update(g, rules, props);
+        rules_parse(g, full);
+        if (props.condOverflow) props.condCount = full.condCount = 0;   // entrées gardées : ordre libre
+        if (!same_props(props, full)) diffs++;
+    }
+    ok &= diffs == 0;
+    return ok;
+}
+
+// ============================================================================
+//  Règles conditionnelles au-delà de MAX_COND_RULES
+//  - 10 règles sur 2 couples (condition, propriété) : 2 entrées, toutes
+//    les règles s’appliquent.
+//  - 12 couples distincts : MAX_COND_RULES entrées, condOverflow levé,
+//    incrémental == complet.
+// ============================================================================
+static bool check_cond_rules()
+{
+    using T = ObjectType;
+    static Grid g;
+    static RuleSet rules;
+    PropertyTable props, full;
+    bool ok = true;
+
+    auto reset = [&]() {
+        g.reset(MAP_WIDTH, MAP_HEIGHT);
+        g.playMaxX = MAP_WIDTH - 1;
+        g.playMaxY = MAP_HEIGHT - 1;
+    };
+
+    // 1) Sujets réunis
+    reset();
+    const T subjects[] = { T::Text_Baba, T::Text_Rock, T::Text_Wall, T::Text_Love, T::Text_Goop };
+    for (int k = 0; k < 5; ++k) {
+        place_words(g, 0, 2 * k, { subjects[k], T::Text_On, T::Text_Flag, T::Text_Is, T::Text_You });
+        place_words(g, 6, 2 * k, { subjects[k], T::Text_On, T::Text_Rock, T::Text_Is, T::Text_Win });
+    }
+    rules.count = 0;
+    rules_update(g, rules, props);
+    rules_parse(g, full);
+    const TypeMask all = type_bit(T::Baba) | type_bit(T::Rock) | type_bit(T::Wall) |
+                         type_bit(T::Love) | type_bit(T::Goop);
+    ok &= rules.count == 10 && props.condCount == 2 && !props.condOverflow && same_props(props, full);
+    ok &= (props.types_at(PROP_YOU, type_bit(T::Flag)) & all) == all;
+    ok &= (props.types_at(PROP_WIN, type_bit(T::Rock)) & all) == all;
+    ok &= (props.types_at(PROP_YOU, type_bit(T::Rock)) & all) == 0;
+
+    // 2) Table pleine
+    reset();
+    const T ons[]      = { T::Text_Flag, T::Text_Rock, T::Text_Wall };
+    const T statuses[] = { T::Text_You, T::Text_Win, T::Text_Push, T::Text_Stop };
+    for (int k = 0; k < 12; ++k)
+        place_words(g, 6 * (k / 6), 2 * (k % 6),
+                    { T::Text_Baba, T::Text_On, ons[k / 4], T::Text_Is, statuses[k % 4] });
+    rules.count = 0;
+    rules_update(g, rules, props);
+    rules_parse(g, full);
+    ok &= rules.count == 12 && props.condCount == MAX_COND_RULES && props.condOverflow;
+    ok &= full.condCount == MAX_COND_RULES && full.condOverflow;
+    ok &= same_props(props, full);
+    return ok;
+}
+
+// ============================================================================
+//  Événements de règles (input_apply)
+//  - Un mot poussé forme FLAG IS WIN : un seul événement Added ; undo et
+//    redo donnent Removed puis Added.
+//  - Une phrase poussée en bloc sur sa ligne, ou un coup sans mot : aucun.
+// ============================================================================
+static bool check_rule_events()
+{
+    using T = ObjectType;
+    static Grid g;
+    static RuleSet rules;
+    static UndoEntry buffer[256];
+    UndoJournal journal(buffer, 256);
+    PropertyTable props;
+    RuleEvents ev;
+    bool ok = true;
+
+    auto reset = [&]() {
+        g.reset(MAP_WIDTH, MAP_HEIGHT);
+        g.playMaxX = MAP_WIDTH - 1;
+        g.playMaxY = MAP_HEIGHT - 1;
+        g.journal = &journal;
+        journal.clear();
+        place_words(g, 0, 0, { T::Text_Baba, T::Text_Is, T::Text_You });
+    };
+
+    reset();
+    place_words(g, 0, 3, { T::Text_Flag, T::Text_Is, T::Empty, T::Text_Win, T::Baba });
+    rules.count = 0;
+    rules_update(g, rules, props);
+
+    auto single = [&](RuleEventKind kind, T word) {
+        return ev.count == 1 && !ev.overflow && ev.events[0].kind == kind &&
+               ev.events[0].rule.word == word && ev.events[0].rule.line == 3 &&
+               ev.events[0].rule.subjects == type_bit(T::Flag);
+    };
+
+    input_apply(g, rules, props, &journal, INPUT_LEFT, &ev);   // WIN poussé : FLAG IS WIN
+    ok &= single(RuleEventKind::Added, T::Text_Win) && props.has(T::Flag, PROP_WIN);
+    input_apply(g, rules, props, &journal, INPUT_DOWN, &ev);   // aucun mot ne bouge
+    ok &= ev.count == 0;
+    input_apply(g, rules, props, &journal, INPUT_UNDO, &ev);
+    ok &= ev.count == 0;
+    input_apply(g, rules, props, &journal, INPUT_UNDO, &ev);
+    ok &= single(RuleEventKind::Removed, T::Text_Win) && !props.has(T::Flag, PROP_WIN);
+    input_apply(g, rules, props, &journal, INPUT_REDO, &ev);
+    ok &= single(RuleEventKind::Added, T::Text_Win);
+
+    // ROCK IS PUSH poussée d’un bloc vers la droite : ligne sale, règle inchangée
+    reset();
+    place_words(g, 1, 10, { T::Baba, T::Text_Rock, T::Text_Is, T::Text_Push });
+    rules_update(g, rules, props);
+    input_apply(g, rules, props, &journal, INPUT_RIGHT, &ev);
+    ok &= ev.count == 0 && props.has(T::Rock, PROP_PUSH);
+    ok &= g.cellTypes[10 * g.width + 3] == type_bit(T::Text_Rock);
+
+    g.journal = nullptr;
+    return ok;
+}
+
+// ============================================================================
+//  Événements de règles au-delà de MAX_RULES
+//  - 64 règles, dont 32 distinctes ; un mot poussé forme FLAG IS WIN :
+//    débordement, événements effacés, table exacte.
+//  - Retour sous MAX_RULES (ROCK IS PUSH cassée) : seuls FLAG IS WIN
+//    (Added) et ROCK IS PUSH (Removed) sont signalés, rien pour les règles
+//    restées en place ; même chose, inversée, en annulant jusqu’au début.
+// ============================================================================
+static bool check_rule_events_overflow()
+{
+    using T = ObjectType;
+    static Grid g;
+    static RuleSet rules;
+    static UndoEntry buffer[256];
+    UndoJournal journal(buffer, 256);
+    PropertyTable props, full;
+    RuleEvents ev;
+
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+    g.journal = &journal;
+    place_words(g, 0, 0, { T::Text_Baba, T::Text_Is, T::Text_You });
+    place_words(g, 0, 3, { T::Text_Flag, T::Text_Is, T::Empty, T::Text_Win, T::Baba });
+    place_words(g, 3, 6, { T::Text_Rock, T::Text_Is, T::Text_Push });
+    const T nouns[] = { T::Text_Wall, T::Text_Lava, T::Text_Goop, T::Text_Love };
+    const T words[] = { T::Text_Stop, T::Text_Sink, T::Text_Kill, T::Text_Hot,
+                        T::Text_Melt, T::Text_Open, T::Text_Shut, T::Text_Float };
+    for (int k = 0; k < MAX_RULES - 2; ++k)   // 8 phrases par ligne paire, y >= 8
+        place_words(g, (k % 8) * 4, 8 + (k / 8) * 2, { nouns[k % 4], T::Text_Is, words[(k / 4) % 8] });
+    rules.count = 0;
+    rules_update(g, rules, props);
+
+    bool ok = rules.count == MAX_RULES;
+    auto exact = [&]() { rules_parse(g, full); return same_props(props, full); };
+    auto has = [&](RuleEventKind kind, T word) {
+        for (int i = 0; i < ev.count; ++i)
+            if (ev.events[i].kind == kind && ev.events[i].rule.word == word) return true;
+        return false;
+    };
+    auto net = [&](RuleEventKind win, RuleEventKind push) {
+        return !ev.overflow && ev.count == 2 && has(win, T::Text_Win) && has(push, T::Text_Push);
+    };
+
+    input_apply(g, rules, props, &journal, INPUT_LEFT, &ev);   // FLAG IS WIN : 65 règles
+    ok &= ev.overflow && ev.count == 0 && props.has(T::Flag, PROP_WIN) && exact();
+    input_apply(g, rules, props, &journal, INPUT_DOWN, &ev);   // toujours 65
+    ok &= ev.overflow && ev.count == 0 && exact();
+    input_apply(g, rules, props, &journal, INPUT_DOWN, &ev);
+    ok &= ev.overflow && ev.count == 0;
+    input_apply(g, rules, props, &journal, INPUT_DOWN, &ev);   // ROCK poussé : 64
+    ok &= net(RuleEventKind::Added, RuleEventKind::Removed);
+    ok &= rules.count == MAX_RULES && !props.has(T::Rock, PROP_PUSH) && exact();
+
+    for (int i = 0; i < 3; ++i) {
+        input_apply(g, rules, props, &journal, INPUT_UNDO, &ev);
+        ok &= ev.overflow && ev.count == 0;
+    }
+    input_apply(g, rules, props, &journal, INPUT_UNDO, &ev);   // état initial
+    ok &= net(RuleEventKind::Removed, RuleEventKind::Added);
+    ok &= rules.count == MAX_RULES && !props.has(T::Flag, PROP_WIN) && exact();
+
+    g.journal = nullptr;
+    return ok;
+}
+
+// ============================================================================
+//  Chaîne de PUSH à travers une case mixte (ROCK sur FLAG)
+//  - Le rocher posé sur le drapeau est poussé, le drapeau reste : jamais
+//    deux objets PUSH dans une même case après le coup.
+//  - YOU face à ROCK sur FLAG pousse le rocher au lieu de le rejoindre.
+//  - Bloqué par un mur derrière la case mixte : rien ne bouge.
+// ============================================================================
+static bool check_push_mixed()
+{
+    using T = ObjectType;
+    static Grid g;
+    static RuleSet rules;
+    PropertyTable props;
+
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+    place_words(g, 0, 0, { T::Text_Baba, T::Text_Is, T::Text_You });
+    place_words(g, 0, 1, { T::Text_Rock, T::Text_Is, T::Text_Push });
+    place_words(g, 0, 2, { T::Text_Wall, T::Text_Is, T::Text_Stop });
+    place_words(g, 4, 5, { T::Flag });
+    place_words(g, 2, 5, { T::Baba, T::Rock, T::Rock });   // ROCK, ROCK sur FLAG, vide
+    place_words(g, 3, 8, { T::Flag });
+    place_words(g, 2, 8, { T::Baba, T::Rock });            // ROCK sur FLAG, vide
+    place_words(g, 3, 11, { T::Flag });
+    place_words(g, 2, 11, { T::Baba, T::Rock, T::Wall });  // ROCK sur FLAG, mur
+    rules.count = 0;
+    rules_update(g, rules, props);
+    step(g, props, 1, 0);
+
+    bool ok = true;
+    const TypeMask push = props.types_with(PROP_PUSH);
+    for (int i = 0; i < g.cell_count(); ++i) {
+        int n = 0;
+        for (const Object& o : g.cell_at(i).objects) n += (type_bit(o.type) & push & ~WORD_TYPES) != 0;
+        ok &= n <= 1;
+    }
+    auto at = [&](int x, int y) { return g.cellTypes[y * g.width + x]; };
+    ok &= at(3, 5) == type_bit(T::Baba) && at(4, 5) == (type_bit(T::Flag) | type_bit(T::Rock));
+    ok &= at(5, 5) == type_bit(T::Rock);
+    ok &= at(3, 8) == (type_bit(T::Flag) | type_bit(T::Baba)) && at(4, 8) == type_bit(T::Rock);
+    ok &= at(2, 11) == type_bit(T::Baba) && at(3, 11) == (type_bit(T::Flag) | type_bit(T::Rock));
+    ok &= g.hash == g.compute_hash();
+    return ok;
+}
+
+// ============================================================================
+//  Capacité des piles (CELL_SPILL_CAP, pool de GRID_SPILL_BLOCKS blocs)
+//  - Une case remplie au-delà de sa capacité, puis un pool épuisé : les
+//    objets refusés ne changent ni la pile, ni l’empreinte.
+//  - Un mobile MOVE face à une case pleine reste en place (demi-tour),
+//    aucun objet n’est perdu.
+//  - stack_transfer vers une case pleine ne déplace rien ; YOU face à une
+//    case pleine, ou poussant une chaîne vers une case pleine, est bloqué
+//    et la chaîne ne bouge pas.
+//  - Une division (ROCK IS FLAG + ROCK IS LOVE) qui ne tient pas dans la
+//    case : copies perdues comptées dans Grid::overflowed.
+// ============================================================================
+static bool check_overflow()
+{
+    using T = ObjectType;
+    static Grid g;
+    static RuleSet rules;
+    PropertyTable props;
+    bool ok = true;
+
+    auto reset = [&]() {
+        g.reset(MAP_WIDTH, MAP_HEIGHT);
+        g.playMaxX = MAP_WIDTH - 1;
+        g.playMaxY = MAP_HEIGHT - 1;
+        g.journal = nullptr;
+        rules.count = 0;
+    };
+    auto fill = [&](int x, int y, T t, int n) {
+        int pushed = 0;
+        for (int k = 0; k < n; ++k) pushed += g.cell(x, y).objects.push_back({t});
+        return pushed;
+    };
+
+    // Une case au-delà de CELL_SPILL_CAP
+    reset();
+    ok &= fill(3, 3, T::Flag, CELL_SPILL_CAP + 1) == CELL_SPILL_CAP;
+    ok &= g.cell(3, 3).objects.size() == CELL_SPILL_CAP && !g.stack_room(3 * g.width + 3, 1);
+    ok &= g.hash == g.compute_hash();
+
+    // Pool épuisé : une pile de plus ne peut plus déborder
+    reset();
+    for (int b = 0; b < GRID_SPILL_BLOCKS; ++b) ok &= fill(b % MAP_WIDTH, 2 + b / MAP_WIDTH, T::Rock, 5) == 5;
+    ok &= fill(0, 10, T::Rock, 5) == CELL_INLINE_CAP && !g.stack_room(10 * g.width, 1);
+    ok &= g.hash == g.compute_hash();
+
+    // MOVE vers une case pleine
+    reset();
+    place_words(g, 0, 0, { T::Text_Rock, T::Text_Is, T::Text_Move });
+    g.cell(2, 5).objects.push_back({T::Rock});
+    fill(3, 5, T::Flag, CELL_SPILL_CAP);
+    rules_update(g, rules, props);
+    const int before = object_count(g);
+    step(g, props, 0, 0);
+    ok &= object_count(g) == before && g.overflowed == 0;
+    ok &= g.cellTypes[5 * g.width + 1] == type_bit(T::Rock) && g.cell(1, 5).objects[0].dir == DIR_LEFT;
+    ok &= g.hash == g.compute_hash();
+
+    // Transfert, YOU et chaîne de PUSH vers une case pleine
+    reset();
+    place_words(g, 0, 0, { T::Text_Baba, T::Text_Is, T::Text_You });
+    place_words(g, 0, 2, { T::Text_Rock, T::Text_Is, T::Text_Push });
+    g.cell(2, 5).objects.push_back({T::Baba});
+    fill(3, 5, T::Flag, CELL_SPILL_CAP);
+    g.cell(2, 8).objects.push_back({T::Baba});
+    g.cell(3, 8).objects.push_back({T::Rock});
+    g.cell(4, 8).objects.push_back({T::Rock});
+    fill(5, 8, T::Flag, CELL_SPILL_CAP);
+    rules_update(g, rules, props);
+    ok &= g.stack_transfer(5 * g.width + 2, 5 * g.width + 3, type_bit(T::Baba)) == -1;
+    const uint64_t h = g.hash;
+    step(g, props, 1, 0);
+    ok &= g.hash == h && g.hash == g.compute_hash() && g.overflowed == 0;
+    step(g, props, 0, 1);   // libre vers le bas : le coup précédent n’a rien bloqué d’autre
+    ok &= g.cellTypes[6 * g.width + 2] == type_bit(T::Baba) && g.cellTypes[9 * g.width + 2] == type_bit(T::Baba);
+
+    // Division qui déborde
+    reset();
+    place_words(g, 0, 0, { T::Text_Rock, T::Text_Is, T::Text_Flag });
+    place_words(g, 0, 2, { T::Text_Rock, T::Text_Is, T::Text_Love });
+    fill(5, 5, T::Rock, 20);
+    rules_update(g, rules, props);
+    apply_transforms(g, props);
+    ok &= g.cell(5, 5).objects.size() == CELL_SPILL_CAP && g.overflowed == 40 - CELL_SPILL_CAP;
+    ok &= g.hash == g.compute_hash();
+    return ok;
+}
+
+// ============================================================================
+//  Allocations : aucune dans la boucle de jeu (operator new compté)
+//  - input_apply() avec journal d’annulation et événements de règles, coups
+//    enchaînés avec undo / redo : niveaux livrés (rechargement hors
+//    comptage sur victoire / mort), soupes d’interactions, puis une grille
+//    qui passe par tous les chemins à la fois : plus de MAX_MOVERS (256)
+//    rochers MOVE, empilés (pool de débordement), ROCK IS FLAG et FLAG IS
+//    ROCK (transformations à chaque coup), GOOP IS SINK et ROCK HAS LOVE
+//    (objets laissés).
+//  - La grille composite doit effectivement emprunter ces chemins.
+// ============================================================================
+static uint64_t play_counted(Grid& g, RuleSet& rules, PropertyTable& props,
+                             UndoJournal& journal, Lcg& rng, int inputs, int level)
+{
+    RuleEvents ev;
+    uint64_t allocs = 0;
+    for (int i = 0; i < inputs; ++i) {
+        const uint32_t k = rng.next() % 10;
+        const InputCode c = k < 8 ? (InputCode)(k & 3) : k == 8 ? INPUT_UNDO : INPUT_REDO;
+        const uint64_t a0 = g_allocs.load();
+        const MoveResult r = input_apply(g, rules, props, &journal, c, &ev);
+        allocs += g_allocs.load() - a0;
+        if (level >= 0 && (r.hasWon || r.hasDied)) {
+            load_level(level, g);
+            rules.count = 0;
+            rules_update(g, rules, props);
+        }
+    }
+    return allocs;
+}
+
+static bool check_no_alloc()
+{
+    using T = ObjectType;
+    static Grid g;
+    static RuleSet rules;
+    static std::vector<UndoEntry> buffer(1 << 16);
+    UndoJournal journal(buffer.data(), (int)buffer.size());
+    PropertyTable props;
+    uint64_t allocs = 0;
+    g.journal = &journal;
+
+    for (int lv = 0; lv < levels_count(); ++lv) {
+        Lcg rng{ 31u + (uint32_t)lv };
+        load_level(lv, g);
+        rules.count = 0;
+        rules_update(g, rules, props);
+        allocs += play_counted(g, rules, props, journal, rng, 1000, lv);
+    }
+    for (uint32_t seed = 1; seed <= 8; ++seed) {
+        Lcg rng{ seed };
+        build_soup(g, seed);
+        rules.count = 0;
+        rules_update(g, rules, props);
+        allocs += play_counted(g, rules, props, journal, rng, 500, -1);
+    }
+
+    // Grille composite
+    Lcg rng{ 4242u };
+    g.reset(MAP_WIDTH, MAP_HEIGHT);
+    g.playMaxX = MAP_WIDTH - 1;
+    g.playMaxY = MAP_HEIGHT - 1;
+    place_words(g, 0, 0, { T::Text_Baba, T::Text_Is, T::Text_You, T::Empty,
+                           T::Text_Rock, T::Text_Is, T::Text_Move, T::Empty,
+                           T::Text_Rock, T::Text_Is, T::Text_Flag, T::Empty,
+                           T::Text_Flag, T::Text_Is, T::Text_Rock, T::Empty,
+                           T::Text_Rock, T::Text_Has, T::Text_Love, T::Empty,
+                           T::Text_Goop, T::Text_Is, T::Text_Sink });
+    int rocks = 0;
+    while (rocks < 300) {
+        const int x = rng.next() % MAP_WIDTH, y = 3 + rng.next() % 19;
+        for (int n = 1 + rng.next() % 6; n > 0; --n, ++rocks)
+            g.cell(x, y).objects.push_back({ T::Rock, (uint8_t)(rng.next() & 3) });
+    }
+    for (int n = 0; n < 40; ++n)
+        g.cell(rng.next() % MAP_WIDTH, 3 + rng.next() % 19).objects.push_back({ T::Goop });
+    g.cell(1, 23).objects.push_back({ T::Baba });
+    const uint32_t spill0 = g.spillUsed;   // piles de départ : déjà débordées
+    rules.count = 0;
+    rules_update(g, rules, props);
+
+    bool spill = false, transformed = false, dropped = false, undone = false;
+    for (int i = 0; i < 300; ++i) {
+        allocs += play_counted(g, rules, props, journal, rng, 1, -1);
+        spill       |= g.spillUsed != spill0;   // blocs pris / rendus en jeu
+        transformed |= g.first_cell_with(type_bit(T::Flag)) >= 0;
+        dropped     |= g.first_cell_with(type_bit(T::Love)) >= 0;
+        undone      |= journal.can_redo();
+    }
+
+    g.journal = nullptr;
+    if (allocs) printf("       %llu allocation(s)\n", (unsigned long long)allocs);
+    return allocs == 0 && spill && transformed && dropped && undone;
+}
+
+// ============================================================================
+//  Pack de niveaux
+//  - Les niveaux chargés, réencodés par LevelPackBuilder, redonnent le pack
+//    intégré octet pour octet.
+//  - Le même pack écrit dans un fichier puis ouvert par levels_open() donne
+//    les mêmes grilles (empreinte, zone jouable).
+//  - Un pack tronqué au milieu de son index (copie interrompue) est refusé
+//    par levels_open() : le pack déjà ouvert reste actif et ses niveaux se
+//    chargent à l’identique.
+//  - Un flux invalide (type inconnu, débordement de la zone) est refusé et
+//    laisse la grille vide.
+// ============================================================================
+static bool check_levelpack(const char* path)
+{
+    static Grid g, other;
+    static uint8_t buffer[16 * 1024];
+    const int levels = levels_count();
+    bool ok = true;
+
+    LevelPackBuilder b;
+    b.begin(buffer, sizeof(buffer), levels);
+    for (int lv = 0; lv < levels; ++lv) {
+        ok &= load_level(lv, g);
+        b.add(g);
+    }
+    const uint32_t bytes = b.finish();
+    ok &= bytes == LEVEL_PACK_BUILTIN_SIZE
+       && std::memcmp(buffer, LEVEL_PACK_BUILTIN, bytes) == 0;
+
+    // Même pack depuis un fichier
+    FILE* f = fopen(path, "wb");
+    ok &= f && fwrite(buffer, 1, bytes, f) == bytes;
+    if (f) fclose(f);
+    ok &= levels_open(path) && levels_count() == levels;
+    for (int lv = 0; lv < levels; ++lv) {
+        levels_use_builtin();
+        load_level(lv, g);
+        ok &= levels_open(path) && load_level(lv, other);
+        ok &= other.state_hash() == g.state_hash();
+    }
+
+    // Pack tronqué : un autre pack (niveaux en ordre inverse, donc un index
+    // différent), coupé au milieu de son index
+    static uint8_t other_pack[16 * 1024];
+    b.begin(other_pack, sizeof(other_pack), levels);
+    for (int lv = levels - 1; lv >= 0; --lv) {
+        levels_use_builtin();
+        load_level(lv, g);
+        b.add(g);
+    }
+    ok &= b.finish() == bytes;
+    char cut[128];
+    snprintf(cut, sizeof(cut), "%s.cut", path);
+    const size_t cutBytes = LEVELPACK_HEADER + LEVELPACK_ENTRY * (levels / 2) + LEVELPACK_ENTRY / 2;
+    f = fopen(cut, "wb");
+    ok &= f && fwrite(other_pack, 1, cutBytes, f) == cutBytes;
+    if (f) fclose(f);
+    ok &= levels_open(path) && !levels_open(cut) && levels_count() == levels;
+    for (int lv = 0; lv < levels; ++lv) {
+        ok &= load_level(lv, other);
+        levels_use_builtin();
+        load_level(lv, g);
+        ok &= other.state_hash() == g.state_hash();
+        ok &= levels_open(path);
+    }
+    std::remove(cut);
+
+    levels_use_builtin();
+    std::remove(path);
+
+    // Flux corrompus
+    LevelPackEntry e;
+    e.width = e.height = 2;
+    const uint8_t badType[] = { (uint8_t)ObjectType::Count };
+    const uint8_t overrun[] = { LEVELPACK_OP_SKIP | 3, (uint8_t)ObjectType::Baba };
+    const uint8_t orphan[]  = { LEVELPACK_OP_REPEAT };
+    for (const uint8_t* bad : { badType, overrun, orphan }) {
+        e.size = (bad == overrun) ? 2 : 1;
+        ok &= !levelpack_decode(e, bad, g) && g.hash == 0;
+    }
+    return ok;
+}
+
+int main()
+{
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    expect(check_levels(2000),        "niveaux : arène == ancien moteur, règles, index, empreinte");
+    expect(check_undo(),              "undo : tout annuler = état initial, tout rejouer = état final");
+    expect(check_undo_nested(),       "undo : coup imbriqué plus grand que le tampon");
+    expect(check_redo_result(),       "undo : redo rend la victoire / la mort du coup d’origine");
+    expect(check_stress(),            "stress : YOU groupés == référence");
+    expect(check_bounce(),            "move : rebond");
+    expect(check_move(5000),          "move : empreinte, undo / redo");
+    expect(check_many_movers(),       "move : plus de MAX_MOVERS mobiles, en lots");
+    expect(check_you_move(),          "move : YOU et MOVE, orientation du dernier coup");
+    expect(check_effects_levels(),    "effects : niveaux, incrémental == passe complète");
+    expect(check_effects_soups(),     "effects : soupes SINK/HOT/MELT/OPEN/SHUT/FLOAT, incrémental == passe complète");
+    expect(check_transforms(),        "transform : chaîne, division, protection, EMPTY, undo");
+    expect(check_parser(20000),       "parser : AND, NOT, HAS, ON, incrémental == complet");
+    expect(check_cond_rules(),        "parser : plus de MAX_COND_RULES règles ON, fusion et débordement signalé");
+    expect(check_rule_events(),       "rule events : ajout, retrait, undo/redo, phrase déplacée");
+    expect(check_rule_events_overflow(), "rule events : au-delà de MAX_RULES, puis retour en dessous");
+    expect(check_push_mixed(),        "push : ROCK sur FLAG poussé, jamais deux PUSH par case");
+    expect(check_overflow(),          "capacité : pile pleine, pool épuisé, YOU / PUSH / MOVE bloqués, division comptée");
+    expect(check_no_alloc(),          "allocations : aucune dans input_apply (MOVE en lots, transformations, HAS, débordement, undo)");
+    expect(check_levelpack("test_engine_levels.pak"),
+                                      "levelpack : réencodage, fichier == intégré, pack tronqué, flux corrompus");
+
+    printf("%d échec(s)\n", g_failed);
+    return g_failed ? 1 : 0;
+}
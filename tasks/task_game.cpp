@@ -13,6 +13,7 @@
 		* Playing → Win / Dead
 		* Win / Dead → Restart
 		* Menu → retour vers Playing
+	- Annulation en jeu : B = undo, C = redo.
 	- Maintenir une cadence stable (~40 FPS).
 
   Notes :
@@ -51,6 +52,7 @@ namespace baba
 	// Fonctions utilitaires pour détecter les appuis (front montant)
 	static inline bool pressed_A(const Keys &now) { return now.A && !s_prevKeys.A; }
 	static inline bool pressed_B(const Keys &now) { return now.B && !s_prevKeys.B; }
+	static inline bool pressed_C(const Keys &now) { return now.C && !s_prevKeys.C; }
 	static inline bool pressed_MENU(const Keys &now) { return now.MENU && !s_prevKeys.MENU; }
 
 	static inline bool pressed_UP(const Keys &now) { return now.up && !s_prevKeys.up; }
@@ -145,6 +147,12 @@ namespace baba
 					game_mode() = GameMode::Menu;
 					break;
 				}
+
+				// B = annuler le dernier coup, C = le rejouer
+				if (pressed_B(k))
+					game_undo();
+				else if (pressed_C(k))
+					game_redo();
 				break;
 
 			case GameMode::Win:
@@ -170,6 +178,11 @@ namespace baba
 				gfx_text_center(140, "Press A to restart", COLOR_WHITE);
 				gfx_flush(); // envoie une fois au LCD
 
+				// Bandeau affiché : décodage du niveau suivant (flash ou carte SD)
+				// et analyse de ses règles pendant que le joueur lit l’écran.
+				// A n’aura plus qu’à recopier un état prêt.
+				game_prefetch_next();
+
 				// Attente non bloquante de l'appui sur A
 				while (!g_keys.A) {
 					vTaskDelay(pdMS_TO_TICKS(25));